@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Process-wide heap allocation counters.
+ *
+ * When built with HFT_TRACK_ALLOCATIONS the global operator new is replaced
+ * by a thin counting wrapper around malloc, so a caller can diff two
+ * snapshots to see how many allocations a block of code performed.
+ * Without the flag the counters stay at zero and isTracking() is false.
+ */
+namespace AllocationStats {
+    struct Counters {
+        std::uint64_t allocations;
+        std::uint64_t bytes;
+
+        Counters() : allocations(0), bytes(0) {}
+    };
+
+    bool isTracking();
+    Counters current();
+
+    // Allocations performed since `start` (taken with current())
+    Counters since(const Counters& start);
+}
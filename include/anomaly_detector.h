@@ -0,0 +1,109 @@
+#pragma once
+
+#include "market_data.h"
+#include <chrono>
+#include <vector>
+
+/**
+ * Exponentially weighted mean and variance of one series, O(1) per sample
+ */
+class EwmaStats {
+public:
+    explicit EwmaStats(int periods = 60);
+
+    void add(double x);
+    // (x - mean) / sigma, with sigma floored at `min_sigma`
+    double zScore(double x, double min_sigma) const;
+
+    double mean() const { return mean_; }
+    double variance() const { return variance_; }
+    int count() const { return count_; }
+
+private:
+    double alpha_;
+    double mean_;
+    double variance_;
+    int count_;
+};
+
+/**
+ * Result of checking one bar
+ */
+struct AnomalyCheck {
+    AnomalyType type;
+    double return_z;
+    double volume_z;
+    bool fresh;   // false when repeated for a bar already checked
+
+    AnomalyCheck() : type(AnomalyType::NONE), return_z(0), volume_z(0), fresh(false) {}
+};
+
+/**
+ * Streaming outlier detector for one symbol's bars.
+ *
+ * Keeps EWMA mean and variance of close-to-close returns and of log volume
+ * and scores each new bar against them before absorbing it. A return
+ * beyond `bad_print_z` sigma without a volume outlier to back it is a bad
+ * print: it is reported and left out of the statistics, so the next bar is
+ * still measured from the last good close. If the price stays there for
+ * MAX_QUARANTINE_RUN bars the move is taken as real and absorbed as a
+ * shock. Otherwise a return beyond `alert_z` is a PRICE_SHOCK, and volume
+ * beyond `alert_z` a VOLUME_SHOCK. Nothing is flagged for the first
+ * MIN_SAMPLES bars.
+ */
+class StreamingAnomalyDetector {
+public:
+    static constexpr int MIN_SAMPLES = 30;
+    static constexpr int MAX_QUARANTINE_RUN = 2;
+    static constexpr double MIN_RETURN_SIGMA = 1e-4;   // 1 bp, for flat stretches
+    static constexpr double MIN_VOLUME_SIGMA = 0.05;   // log volume
+
+    explicit StreamingAnomalyDetector(int periods = 60, double alert_z = 4.0, double bad_print_z = 8.0);
+
+    AnomalyCheck push(const OHLCV& bar);
+    AnomalyCheck amendLast(const OHLCV& bar);
+
+    bool ready() const { return state_.returns.count() >= MIN_SAMPLES; }
+
+private:
+    struct State {
+        EwmaStats returns;
+        EwmaStats log_volume;
+        Price last_close;       // last bar absorbed (bad prints excluded)
+        int quarantine_run;
+
+        explicit State(int periods) : returns(periods), log_volume(periods), quarantine_run(0) {}
+    };
+
+    double alert_z_;
+    double bad_print_z_;
+    State state_;
+    State before_last_;
+
+    AnomalyCheck apply(State& state, const OHLCV& bar) const;
+};
+
+/**
+ * A StreamingAnomalyDetector per symbol, indexed by SymbolId, fed bars
+ * under the IntradayBarStore rules (newer pushes, same timestamp amends,
+ * older bars are already checked and read as NONE). A resent newest bar
+ * returns its earlier result, not fresh, so a caller replaying the session
+ * escalates a shock once, when its bar arrives.
+ * Not thread-safe: owned and updated by the data thread.
+ */
+class AnomalyMonitor {
+public:
+    AnomalyCheck check(SymbolId symbol, const OHLCV& bar);
+
+    size_t memoryBytes() const { return symbols_.capacity() * sizeof(SymbolState); }
+
+private:
+    struct SymbolState {
+        StreamingAnomalyDetector detector;
+        OHLCV last_bar;
+        AnomalyCheck last_check;
+        bool has_bar = false;
+    };
+
+    std::vector<SymbolState> symbols_;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "indicator_batch.h"
+#include "market_data.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Rolling Pearson correlation of per-bar returns for every pair of symbols.
+ *
+ * Returns are quantized to fixed point (RETURN_SCALE units per 1.0) and
+ * their sums, squares and pairwise cross products are kept in int64, so a
+ * bar close adds the new return row and removes the row leaving the window
+ * exactly: O(N^2) per bar, nothing recomputed over the window, no drift.
+ * The cross products form the upper triangle of an N x N matrix updated a
+ * row at a time, four pairs per instruction with AVX2.
+ *
+ * Lanes are SymbolIds. A missing close (0) or a symbol's first close counts
+ * as a zero return.
+ * Not thread-safe: owned and updated by the data thread.
+ */
+class CorrelationMatrix {
+public:
+    static constexpr double RETURN_SCALE = 1e6;
+    static constexpr size_t MIN_SAMPLES = 20;   // correlation() reads 0 before this
+
+    explicit CorrelationMatrix(size_t symbols = 0, size_t window = 60);
+
+    // Drop all history and size for `symbols` lanes over `window` returns
+    void reset(size_t symbols, size_t window);
+    // Grow to `symbols` lanes, keeping the history of existing lanes
+    void resize(size_t symbols);
+
+    // Absorb one bar close per lane (paise, indexed by SymbolId)
+    void update(Span<const std::int32_t> closes);
+
+    // In [-1, 1]; 0 for unknown lanes, flat series, or too few samples
+    double correlation(SymbolId a, SymbolId b) const;
+
+    size_t size() const { return symbols_; }
+    size_t window() const { return window_; }
+    size_t samples() const { return samples_; }
+    bool ready() const { return samples_ >= MIN_SAMPLES; }
+    size_t memoryBytes() const;
+
+    BatchKernel kernel() const { return kernel_; }
+    // Force a kernel (benchmarks, parity checks); falls back to SCALAR if unsupported
+    void setKernel(BatchKernel kernel);
+
+private:
+    size_t symbols_;
+    size_t window_;
+    size_t samples_;   // returns in the window, up to window_
+    size_t head_;      // row holding the oldest return
+    BatchKernel kernel_;
+
+    std::vector<std::int32_t> prev_close_;   // paise
+    std::vector<std::int64_t> returns_;      // window_ rows of symbols_ returns
+    std::vector<std::int64_t> sum_;          // per lane
+    std::vector<std::int64_t> cross_;        // symbols_ x symbols_, upper triangle (diagonal = squares)
+    std::vector<std::int64_t> removed_;      // scratch: the row leaving the window
+
+    void updateCrossScalar(const std::int64_t* added, const std::int64_t* removed);
+    void updateCrossAVX2(const std::int64_t* added, const std::int64_t* removed);
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory_resource>
+#include <optional>
+#include <vector>
+#include <cstddef>
+
+/**
+ * Monotonic arena for objects that live for one analysis cycle.
+ *
+ * Allocations bump a pointer through a preallocated buffer and are released
+ * all at once by reset(). If a cycle outgrows the buffer the overflow comes
+ * from the heap and the buffer is enlarged at the next reset, so after the
+ * first few cycles the arena serves every request without touching malloc.
+ *
+ * Containers built on resource() must be destroyed (or reassigned) before
+ * reset(); copy results out of the arena rather than moving them, since a
+ * moved pmr container keeps pointing at arena memory.
+ */
+class CycleArena {
+public:
+    explicit CycleArena(size_t initial_bytes = 64 * 1024);
+
+    CycleArena(const CycleArena&) = delete;
+    CycleArena& operator=(const CycleArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &tracker_; }
+
+    // Release everything allocated since the last reset
+    void reset();
+
+    size_t bytesUsed() const { return tracker_.bytes_used; }
+    size_t peakBytes() const { return peak_bytes_; }
+    size_t capacity() const { return buffer_.size(); }
+
+private:
+    // Forwards to the current monotonic resource and counts bytes handed out
+    class TrackingResource : public std::pmr::memory_resource {
+    public:
+        explicit TrackingResource(CycleArena& arena) : arena_(arena), bytes_used(0) {}
+
+        CycleArena& arena_;
+        size_t bytes_used;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    std::vector<std::byte> buffer_;
+    std::optional<std::pmr::monotonic_buffer_resource> monotonic_;
+    TrackingResource tracker_;
+    size_t peak_bytes_;
+};
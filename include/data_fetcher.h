@@ -23,7 +23,7 @@ public:
     std::map<std::string, StockData> getCurrentStocks();
     StockData getStock(const std::string& symbol);
     HistoricalData getHistoricalData(const std::string& symbol, 
-                                   const std::string& period = "1mo");
+                                   const std::string& period = "6mo");
     
     // Market scan
     MarketScan getMarketScan();
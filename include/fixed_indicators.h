@@ -0,0 +1,331 @@
+#pragma once
+
+#include "market_data.h"
+#include "technical_indicators.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ratio>
+
+/*
+ * Compile-time period variants of the Streaming* indicators, for the fixed
+ * periods IndicatorState tracks for every symbol (SMA 20/50, EMA 9/21,
+ * RSI 14, ATR 14, Bollinger 20 x 2.0).
+ *
+ * With the period a template argument, warm-up checks compare against an
+ * immediate, the smoothing constants are constexpr, and the close windows
+ * are inline fixed arrays instead of heap ring buffers, so a symbol's
+ * whole indicator state sits in one allocation. Each kernel performs the
+ * same arithmetic in the same order as its Streaming* counterpart, so the
+ * values are bit-identical; Streaming* stays the runtime-period fallback.
+ */
+namespace FixedPeriod {
+
+/**
+ * Newest N closes (paise) in a mirrored inline array, like RingBuffer
+ */
+template <size_t N>
+class CloseWindow {
+public:
+    static_assert(N > 0, "window must hold at least one close");
+
+    void push(std::int32_t close) {
+        storage_[head_] = close;
+        storage_[head_ + N] = close;
+        head_ = (head_ + 1 == N) ? 0 : head_ + 1;
+        if (count_ < N) ++count_;
+    }
+
+    void replaceLast(std::int32_t close) {
+        size_t slot = (head_ == 0) ? N - 1 : head_ - 1;
+        storage_[slot] = close;
+        storage_[slot + N] = close;
+    }
+
+    std::int32_t front() const { return storage_[head_ + N - count_]; }
+    std::int32_t back() const { return storage_[(head_ == 0 ? N : head_) - 1]; }
+
+    // Oldest-to-newest
+    Span<const std::int32_t> view() const { return Span<const std::int32_t>(storage_.data() + head_ + N - count_, count_); }
+
+    bool empty() const { return count_ == 0; }
+    bool full() const { return count_ == N; }
+
+private:
+    std::array<std::int32_t, 2 * N> storage_ = {};
+    size_t head_ = 0;    // next write slot
+    size_t count_ = 0;
+};
+
+/**
+ * Simple moving average of closes (see StreamingSMA)
+ */
+template <int Periods>
+class Sma {
+public:
+    static_assert(Periods > 0, "period must be positive");
+
+    void push(const OHLCV& bar) {
+        if (closes_.full()) sum_ -= closes_.front();
+        closes_.push(bar.close.paise);
+        sum_ += bar.close.paise;
+    }
+
+    void amendLast(const OHLCV& bar) {
+        if (closes_.empty()) {
+            push(bar);
+            return;
+        }
+        sum_ += static_cast<std::int64_t>(bar.close.paise) - closes_.back();
+        closes_.replaceLast(bar.close.paise);
+    }
+
+    bool ready() const { return closes_.full(); }
+    double value() const { return ready() ? static_cast<double>(sum_) / Periods / 100.0 : 0.0; }
+    static constexpr int periods() { return Periods; }
+
+private:
+    CloseWindow<Periods> closes_;
+    std::int64_t sum_ = 0;
+};
+
+/**
+ * Exponential moving average, seeded with the SMA of the first `Periods` closes
+ */
+template <int Periods>
+class Ema {
+public:
+    static_assert(Periods > 0, "period must be positive");
+
+    static constexpr double ALPHA = 2.0 / (Periods + 1);
+    static constexpr double DECAY = 1 - ALPHA;
+
+    void push(const OHLCV& bar) {
+        before_last_ = state_;
+        apply(state_, bar.close);
+    }
+
+    void amendLast(const OHLCV& bar) {
+        state_ = before_last_;
+        apply(state_, bar.close);
+    }
+
+    bool ready() const { return state_.count >= Periods; }
+    double value() const { return ready() ? state_.ema : 0.0; }
+    static constexpr int periods() { return Periods; }
+
+private:
+    struct State {
+        double ema = 0;
+        std::int64_t seed_sum = 0;   // paise, until the first `Periods` closes are in
+        int count = 0;
+    };
+
+    State state_;
+    State before_last_;
+
+    static void apply(State& state, Price close) {
+        if (state.count < Periods) {
+            state.seed_sum += close.paise;
+            if (++state.count == Periods) {
+                state.ema = static_cast<double>(state.seed_sum) / Periods / 100.0;
+            }
+            return;
+        }
+        state.ema = close.toDouble() * ALPHA + state.ema * DECAY;
+    }
+};
+
+/**
+ * RSI with Wilder's smoothing (see StreamingRSI)
+ */
+template <int Periods>
+class Rsi {
+public:
+    static_assert(Periods > 0, "period must be positive");
+
+    static constexpr double KEEP = Periods - 1;   // weight of the previous average
+
+    void push(const OHLCV& bar) {
+        before_last_ = state_;
+        apply(state_, bar.close);
+    }
+
+    void amendLast(const OHLCV& bar) {
+        state_ = before_last_;
+        apply(state_, bar.close);
+    }
+
+    bool ready() const { return state_.changes >= Periods; }
+    double value() const {
+        if (!ready()) return 50.0;
+        if (state_.avg_loss == 0) return 100.0;
+
+        double rs = state_.avg_gain / state_.avg_loss;
+        return 100.0 - (100.0 / (1.0 + rs));
+    }
+    static constexpr int periods() { return Periods; }
+    double averageGain() const { return state_.avg_gain; }
+    double averageLoss() const { return state_.avg_loss; }
+    Price previousClose() const { return state_.prev_close; }
+
+private:
+    struct State {
+        Price prev_close;
+        bool has_prev = false;
+        double avg_gain = 0;
+        double avg_loss = 0;
+        int changes = 0;
+    };
+
+    State state_;
+    State before_last_;
+
+    static void apply(State& state, Price close) {
+        if (!state.has_prev) {
+            state.prev_close = close;
+            state.has_prev = true;
+            return;
+        }
+
+        double change = (close - state.prev_close).toDouble();
+        double gain = change > 0 ? change : 0;
+        double loss = change < 0 ? -change : 0;
+        state.prev_close = close;
+
+        if (state.changes < Periods) {
+            state.avg_gain += gain;
+            state.avg_loss += loss;
+            if (++state.changes == Periods) {
+                state.avg_gain /= Periods;
+                state.avg_loss /= Periods;
+            }
+            return;
+        }
+
+        state.avg_gain = ((state.avg_gain * KEEP) + gain) / Periods;
+        state.avg_loss = ((state.avg_loss * KEEP) + loss) / Periods;
+    }
+};
+
+/**
+ * Average True Range with Wilder's smoothing (see StreamingATR)
+ */
+template <int Periods>
+class Atr {
+public:
+    static_assert(Periods > 0, "period must be positive");
+
+    static constexpr double KEEP = Periods - 1;
+
+    void push(const OHLCV& bar) {
+        before_last_ = state_;
+        apply(state_, bar);
+    }
+
+    void amendLast(const OHLCV& bar) {
+        state_ = before_last_;
+        apply(state_, bar);
+    }
+
+    bool ready() const { return state_.ranges >= Periods; }
+    double value() const { return ready() ? state_.atr : 0.0; }
+    static constexpr int periods() { return Periods; }
+    Price previousClose() const { return state_.prev.close; }
+
+private:
+    struct State {
+        OHLCV prev;
+        bool has_prev = false;
+        double atr = 0;
+        int ranges = 0;
+    };
+
+    State state_;
+    State before_last_;
+
+    static void apply(State& state, const OHLCV& bar) {
+        if (!state.has_prev) {
+            state.prev = bar;
+            state.has_prev = true;
+            return;
+        }
+
+        double true_range = TechnicalIndicators::calculateTrueRange(bar, state.prev);
+        state.prev = bar;
+
+        if (state.ranges < Periods) {
+            state.atr += true_range;
+            if (++state.ranges == Periods) {
+                state.atr /= Periods;
+            }
+            return;
+        }
+
+        state.atr = ((state.atr * KEEP) + true_range) / Periods;
+    }
+};
+
+/**
+ * Bollinger Bands from running sums of closes and squared closes (paise).
+ * The multiplier is a std::ratio, so Bollinger<20> is the 20 x 2.0 band.
+ */
+template <int Periods, typename Multiplier = std::ratio<2>>
+class Bollinger {
+public:
+    static_assert(Periods > 0, "period must be positive");
+
+    static constexpr double MULTIPLIER = static_cast<double>(Multiplier::num) / Multiplier::den;
+
+    void push(const OHLCV& bar) {
+        if (closes_.full()) {
+            std::int64_t oldest = closes_.front();
+            sum_ -= oldest;
+            sum_sq_ -= oldest * oldest;
+        }
+        std::int64_t close = bar.close.paise;
+        closes_.push(bar.close.paise);
+        sum_ += close;
+        sum_sq_ += close * close;
+    }
+
+    void amendLast(const OHLCV& bar) {
+        if (closes_.empty()) {
+            push(bar);
+            return;
+        }
+        std::int64_t previous = closes_.back();
+        std::int64_t close = bar.close.paise;
+        sum_ += close - previous;
+        sum_sq_ += close * close - previous * previous;
+        closes_.replaceLast(bar.close.paise);
+    }
+
+    bool ready() const { return closes_.full(); }
+    BollingerBands value() const {
+        if (!ready()) return BollingerBands();
+
+        double mean = static_cast<double>(sum_) / Periods;
+        double variance = static_cast<double>(sum_sq_) / Periods - mean * mean;
+        double std_dev = std::sqrt(std::max(0.0, variance)) / 100.0;
+        double middle = mean / 100.0;
+
+        return BollingerBands(
+            middle + (MULTIPLIER * std_dev),
+            middle,
+            middle - (MULTIPLIER * std_dev)
+        );
+    }
+    static constexpr int periods() { return Periods; }
+    static constexpr double multiplier() { return MULTIPLIER; }
+    Span<const std::int32_t> window() const { return closes_.view(); }   // paise, oldest first
+
+private:
+    CloseWindow<Periods> closes_;
+    std::int64_t sum_ = 0;
+    std::int64_t sum_sq_ = 0;
+};
+
+}
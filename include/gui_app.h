@@ -5,6 +5,8 @@
 #include "yahoo_finance_api.h"
 #include "strategy_engine.h"
 #include "history_manager.h"
+#include "snapshot_channel.h"
+#include "memory_budget.h"
 
 #include <TGUI/TGUI.hpp>
 #include <TGUI/Backend/SFML-Graphics.hpp>
@@ -14,6 +16,16 @@
 #include <atomic>
 #include <chrono>
 
+/**
+ * Everything one data cycle produces, published to the GUI thread as a unit
+ */
+struct MarketView {
+    std::shared_ptr<const MarketSnapshot> snapshot;
+    MarketScan scan;
+    std::vector<TradingSetup> setups;   // sorted by confidence
+    std::chrono::system_clock::time_point update_time;
+};
+
 /**
  * Main GUI Application for HFT Trading System
  */
@@ -36,17 +48,25 @@ private:
     std::unique_ptr<StrategyEngine> strategy_engine_;
     std::unique_ptr<HistoryManager> history_manager_;
     
-    // Data management
-    std::map<std::string, StockData> current_stocks_;
+    // Data management (data thread only)
+    std::shared_ptr<const MarketSnapshot> current_snapshot_;
     std::map<std::string, HistoricalData> historical_data_;
     MarketScan current_scan_;
     std::vector<TradingSetup> current_setups_;
+    std::chrono::system_clock::time_point last_update_;
+    
+    // Data thread -> GUI thread hand-off
+    SnapshotChannel<MarketView> market_views_;
+    const MarketView* displayed_view_;   // GUI thread only
+    std::uint64_t displayed_version_;
+    
+    // Accounting: data thread reports candles/indicators, GUI thread history/gui
+    MemoryBudget memory_budget_;
     
     // Threading and updates
     std::atomic<bool> running_;
     std::atomic<bool> data_update_active_;
     std::thread data_update_thread_;
-    std::chrono::system_clock::time_point last_update_;
     
     // GUI Components
     tgui::Panel::Ptr main_panel_;
@@ -75,6 +95,8 @@ private:
     tgui::Panel::Ptr status_panel_;
     tgui::Label::Ptr market_status_label_;
     tgui::Label::Ptr last_update_label_;
+    tgui::Label::Ptr memory_label_;
+    tgui::Label::Ptr breadth_label_;
     tgui::ProgressBar::Ptr update_progress_;
     tgui::Button::Ptr refresh_button_;
     tgui::Button::Ptr auto_refresh_button_;
@@ -88,6 +110,9 @@ private:
         double min_confidence_threshold = 0.6;
         bool sound_alerts = true;
         std::string theme_name = "Dark";
+        BarStoreConfig bar_store;   // [data] intraday_bars_* in config.ini
+        size_t memory_limit_mb = 512;   // [advanced] memory_limit_mb
+        double max_correlation_limit = 0.7;   // [risk_management] max_correlation_limit
     } config_;
     
     // Initialization methods
@@ -107,14 +132,18 @@ private:
     void updateMarketData();
     void updateTradingSetups();
     void updateMarketScan();
+    void publishMarketView();
+    void enforceMemoryBudget();
     
-    // GUI update methods
+    // GUI update methods (GUI thread, render displayed_view_)
+    void refreshDisplayedView();
     void updateLiveDataTable();
     void updateSetupsPanel();
     void updateMarketScanLists();
     void updateHistoryList();
     void updateStatusBar();
     void updateMarketStatus();
+    void updateMemoryStatus();
     
     // Event handlers
     void onWindowClosed();
@@ -150,6 +179,7 @@ private:
     static const int MIN_WINDOW_HEIGHT = 800;
     static const int MAX_SETUPS_DISPLAY = 20;
     static const int MAX_HISTORY_ITEMS = 1000;
+    static const size_t GUI_ROW_BYTES_ESTIMATE = 512;
 };
 
 /**
@@ -40,7 +40,11 @@ public:
     
     // Maintenance
     void cleanupOldRecords(int days_to_keep = 90);
+    // Drop the oldest records until about `bytes_to_free` is released, keeping
+    // the last day's. Returns bytes freed.
+    size_t trimOldestRecords(size_t bytes_to_free);
     size_t getRecordCount() const;
+    size_t memoryBytes() const;
     
 private:
     std::string data_directory_;
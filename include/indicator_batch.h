@@ -0,0 +1,100 @@
+#pragma once
+
+#include "market_data.h"
+#include "streaming_indicators.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * One bar for every symbol in a batch, laid out structure-of-arrays (paise)
+ */
+struct BarColumn {
+    std::vector<std::int32_t> high;
+    std::vector<std::int32_t> low;
+    std::vector<std::int32_t> close;
+
+    explicit BarColumn(size_t symbols = 0) { resize(symbols); }
+
+    void resize(size_t symbols);
+    size_t size() const { return close.size(); }
+    void set(size_t index, const OHLCV& bar);
+};
+
+/**
+ * Instruction set used by IndicatorBatch::update
+ */
+enum class BatchKernel {
+    SCALAR,
+    AVX2
+};
+
+/**
+ * Cross-sectional EMA(9/21), RSI(14), ATR(14) and Bollinger(20) state for a
+ * whole symbol universe, updated one bar close at a time.
+ *
+ * State is symbols-by-time: one array per quantity with a lane per symbol,
+ * and the Bollinger window stored as `periods` rows of closes so every
+ * symbol drops and adds its close at the same row. update() walks the
+ * arrays four symbols at a time with AVX2 where the CPU has it, otherwise
+ * one at a time; both kernels perform the same operations in the same order
+ * and produce identical results to the Streaming* classes, provided this
+ * file and streaming_indicators.cpp are built with -ffp-contract=off (the
+ * Makefile and CMakeLists do so), since a fused multiply-add in the scalar
+ * code rounds differently. make bench checks it.
+ *
+ * Warm-up is not vectorised: a symbol joins through seed() once its
+ * IndicatorState is warm, and until then its lane is ignored.
+ */
+class IndicatorBatch {
+public:
+    explicit IndicatorBatch(size_t symbols, int bollinger_periods = 20, double bollinger_multiplier = 2.0);
+
+    // Copy a warmed-up symbol's streaming state into lane `index`.
+    // Returns false (lane left inactive) if the state is not warm yet.
+    bool seed(size_t index, const IndicatorState& state);
+
+    // Absorb one closed bar per symbol; bars.size() must equal size()
+    void update(const BarColumn& bars);
+
+    // rsi_14, ema_9, ema_21, atr_14, sma_20, bollinger_upper/lower
+    void apply(size_t index, StockData& stock) const;
+
+    double ema9(size_t index) const { return ema_9_[index]; }
+    double ema21(size_t index) const { return ema_21_[index]; }
+    double rsi(size_t index) const;
+    double atr(size_t index) const { return atr_[index]; }
+    BollingerBands bollinger(size_t index) const;
+
+    size_t size() const { return symbols_; }
+    bool isSeeded(size_t index) const { return seeded_[index] != 0; }
+
+    BatchKernel kernel() const { return kernel_; }
+    // Force a kernel (benchmarks, parity checks); falls back to SCALAR if unsupported
+    void setKernel(BatchKernel kernel);
+
+    static BatchKernel bestKernel();
+    static const char* kernelName(BatchKernel kernel);
+
+private:
+    size_t symbols_;
+    int bollinger_periods_;
+    double bollinger_multiplier_;
+    BatchKernel kernel_;
+
+    std::vector<double> ema_9_;
+    std::vector<double> ema_21_;
+    std::vector<double> avg_gain_;
+    std::vector<double> avg_loss_;
+    std::vector<double> atr_;
+    std::vector<std::int32_t> prev_close_;   // paise
+
+    std::vector<std::int32_t> window_;       // bollinger_periods_ rows of symbols_ closes
+    size_t window_head_;                     // row holding the oldest close
+    std::vector<std::int64_t> sum_;          // paise
+    std::vector<std::int64_t> sum_sq_;       // paise squared
+
+    std::vector<std::uint8_t> seeded_;
+
+    void updateScalar(const BarColumn& bars, size_t begin, size_t end);
+    void updateAVX2(const BarColumn& bars);
+};
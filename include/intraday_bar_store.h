@@ -0,0 +1,150 @@
+#pragma once
+
+#include "market_data.h"
+#include "ring_buffer.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Bar timeframes kept per symbol
+ */
+enum class BarInterval {
+    ONE_MINUTE,
+    FIVE_MINUTES,
+    FIFTEEN_MINUTES,
+    DAILY
+};
+
+constexpr size_t BAR_INTERVAL_COUNT = 4;
+
+/**
+ * Length of one bar. DAILY buckets are UTC days, which hold the whole
+ * 09:15-15:30 IST session; 5m and 15m buckets start on 09:15 IST because
+ * 03:45 UTC is a multiple of 15 minutes.
+ */
+constexpr std::chrono::minutes barPeriod(BarInterval interval) {
+    return interval == BarInterval::ONE_MINUTE ? std::chrono::minutes(1)
+         : interval == BarInterval::FIVE_MINUTES ? std::chrono::minutes(5)
+         : interval == BarInterval::FIFTEEN_MINUTES ? std::chrono::minutes(15)
+         : std::chrono::minutes(24 * 60);
+}
+
+constexpr size_t SESSION_MINUTES = 375;   // 09:15-15:30 IST
+constexpr size_t MIN_DAILY_BARS = 50;     // SMA(50), the longest daily lookback
+
+// Bars a trimmed series keeps: one whole session intraday, MIN_DAILY_BARS daily
+constexpr size_t trimmedBars(BarInterval interval) {
+    return interval == BarInterval::DAILY ? MIN_DAILY_BARS
+         : static_cast<size_t>(SESSION_MINUTES / barPeriod(interval).count());
+}
+
+/**
+ * Rolls a lower-timeframe series up into the bar of the current bucket.
+ *
+ * The lower series' newest bar may still be forming, so it is kept apart
+ * from the bars already folded into the bucket: amending it (same
+ * timestamp) costs one merge, and it is folded in when a newer lower bar
+ * arrives. Higher timeframes chain aggregators, each fed the one below.
+ */
+class BarAggregator {
+public:
+    explicit BarAggregator(BarInterval interval = BarInterval::FIVE_MINUTES);
+
+    // Absorb the newest lower-timeframe bar; false (ignored) if it is older
+    bool update(const OHLCV& bar);
+    void reset();
+
+    // The current bucket's bar, timestamped at the bucket start
+    const OHLCV& current() const { return current_; }
+    bool empty() const { return !has_newest_; }
+
+private:
+    std::chrono::minutes period_;
+    OHLCV folded_;      // lower bars of the bucket before the newest
+    bool has_folded_;
+    OHLCV newest_;
+    bool has_newest_;
+    OHLCV current_;
+
+    std::chrono::system_clock::time_point bucketStart(std::chrono::system_clock::time_point time) const;
+    static void merge(OHLCV& into, const OHLCV& bar);
+};
+
+/**
+ * Per-timeframe ring capacities (bars), see [data] in config.ini
+ */
+struct BarStoreConfig {
+    std::array<size_t, BAR_INTERVAL_COUNT> capacity;
+
+    // One full 09:15-15:30 session of 1m bars, ~5 sessions of 5m,
+    // ~5 sessions of 15m and one trading year of daily bars
+    BarStoreConfig() : capacity{{375, 375, 125, 250}} {}
+
+    size_t capacityFor(BarInterval interval) const { return capacity[static_cast<size_t>(interval)]; }
+};
+
+/**
+ * Bounded per-symbol, per-timeframe bar storage.
+ *
+ * Buffers are allocated once when a symbol is first seen (or up front via
+ * reserveSymbols), after which ingesting bars never allocates, so memory
+ * per symbol is constant however long the session runs.
+ * Under memory pressure trimColdHistory() shrinks the series to the
+ * current session (MIN_DAILY_BARS for daily), dropping only bars from
+ * earlier sessions; the session's own bars, which the rollups, scanners and
+ * intraday indicators read, are never released. Once there is room again
+ * restoreCapacity() grows trimmed series back to their configured capacity.
+ * Not thread-safe: owned and updated by the data thread.
+ */
+class IntradayBarStore {
+public:
+    explicit IntradayBarStore(const BarStoreConfig& config = BarStoreConfig());
+
+    void configure(const BarStoreConfig& config);
+    void reserveSymbols(size_t symbol_count);
+
+    // Append a bar newer than the last stored one, replace the last bar when
+    // the timestamp matches (in-progress bar update), ignore older bars
+    void ingest(SymbolId symbol, BarInterval interval, const OHLCV& bar);
+    void ingest(SymbolId symbol, BarInterval interval, CandleSpan bars);
+    // Ingest a 1m bar and roll it up into the 5m, 15m and daily series
+    void ingestBase(SymbolId symbol, const OHLCV& bar);
+
+    // Contiguous oldest-to-newest views for indicator kernels
+    CandleSpan bars(SymbolId symbol, BarInterval interval) const;
+    CandleSpan recent(SymbolId symbol, BarInterval interval, size_t count) const;
+
+    size_t barCount(SymbolId symbol, BarInterval interval) const;
+    size_t symbolCount() const { return series_.size(); }
+    size_t memoryBytes() const;
+
+    // Shrink least-recently-updated symbols' series to trimmedBars() until
+    // `bytes_to_free` is released or nothing older than the session is left.
+    // Returns bytes freed.
+    size_t trimColdHistory(size_t bytes_to_free);
+    // Grow trimmed series back to the configured capacity, most recently
+    // updated first, while the growth fits in `bytes_available`. Returns
+    // bytes added.
+    size_t restoreCapacity(size_t bytes_available);
+
+private:
+    struct SeriesSet {
+        std::array<RingBuffer<OHLCV>, BAR_INTERVAL_COUNT> buffers;
+        std::array<BarAggregator, BAR_INTERVAL_COUNT - 1> rollups;   // 5m from 1m, 15m from 5m, daily from 15m
+        std::uint64_t last_ingest;   // ingest_clock_ value of the latest bar
+        bool trimmed;                // below the configured capacity
+
+        SeriesSet();
+    };
+
+    BarStoreConfig config_;
+    std::vector<SeriesSet> series_;   // indexed by SymbolId
+    std::uint64_t ingest_clock_;
+
+    SeriesSet& seriesFor(SymbolId symbol);
+    void allocate(SeriesSet& set) const;
+    std::vector<SymbolId> byLastIngest() const;   // coldest first
+    static size_t setBytes(const SeriesSet& set);
+};
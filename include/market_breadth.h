@@ -0,0 +1,80 @@
+#pragma once
+
+#include "market_data.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Index level rebuilt from constituent prices, with market and sector
+ * breadth, all maintained from per-symbol deltas.
+ *
+ * Each constituent holds free-float units of weight / previous close, so
+ * the index relative to its own previous close is sum(units * price) over
+ * sum(weight) across the constituents priced so far. update() takes the
+ * symbol's old contribution out of those sums and of the advance/decline,
+ * VWAP and SMA(50) counts and puts the new one in: O(1) per symbol, never a
+ * pass over the universe. The level is that ratio times the index's
+ * previous close (setReference), needed once per session; a constituent's
+ * previous close moving marks a new session and clears it. Symbols outside
+ * the index count toward breadth only.
+ * Not thread-safe: owned and updated by the data thread.
+ */
+class MarketBreadthEngine {
+public:
+    explicit MarketBreadthEngine(
+        Span<const IndexConstituent> constituents = MarketDataUtils::getNifty50Constituents());
+
+    void update(const StockData& stock);
+
+    bool needsReference() const { return !has_reference_; }
+    void setReference(double index_previous_close);
+
+    // Current totals, O(SECTOR_COUNT)
+    MarketBreadth breadth() const;
+    // Index points the symbol adds or takes away today (0 without a reference)
+    double contribution(SymbolId symbol) const;
+
+    size_t memoryBytes() const { return symbols_.capacity() * sizeof(SymbolState); }
+
+private:
+    // Bit positions in SymbolState::flags, and indices into counts_
+    enum Flag : int {
+        ADVANCING,
+        DECLINING,
+        UNCHANGED,
+        HAS_VWAP,
+        ABOVE_VWAP,
+        HAS_SMA_50,
+        ABOVE_SMA_50,
+        FLAG_COUNT
+    };
+
+    struct SymbolState {
+        Sector sector = Sector::UNCLASSIFIED;
+        double weight = 0;      // 0 outside the index
+        double units = 0;       // weight / previous close (rupees)
+        Price previous_close;
+        Price price;
+        std::uint8_t flags = 0;
+        bool priced = false;
+    };
+
+    struct Totals {
+        double weighted_price = 0;   // sum(units * price)
+        double weight = 0;           // sum(weight) of the same constituents
+    };
+
+    std::vector<SymbolState> symbols_;   // by SymbolId
+    std::array<int, FLAG_COUNT> counts_;
+    std::array<std::array<int, UNCHANGED + 1>, SECTOR_COUNT> sector_counts_;   // advancing, declining, unchanged
+    std::array<Totals, SECTOR_COUNT> sector_totals_;
+    Totals index_;
+    int constituents_priced_;
+    double reference_;
+    bool has_reference_;
+
+    SymbolState& stateFor(SymbolId symbol);
+    // Add (sign = 1) or remove (sign = -1) a symbol's contribution
+    void apply(const SymbolState& state, int sign);
+};
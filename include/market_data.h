@@ -1,62 +1,122 @@
 #pragma once
 
+#include "price.h"
+#include "span.h"
+#include <array>
 #include <string>
 #include <vector>
 #include <chrono>
 #include <map>
+#include <memory>
+#include <cstdint>
 
 // Forward declarations
 struct OHLCV;
 struct StockData;
 struct MarketScan;
 
+/**
+ * Compact interned symbol identifier (see SymbolTable)
+ */
+using SymbolId = std::uint32_t;
+constexpr SymbolId INVALID_SYMBOL_ID = 0xFFFFFFFFu;
+
 /**
  * OHLCV data structure for candlestick data
  */
 struct OHLCV {
-    double open;
-    double high;
-    double low;
-    double close;
-    long long volume;
+    Price open;
+    Price high;
+    Price low;
+    Price close;
+    Quantity volume;
     std::chrono::system_clock::time_point timestamp;
     
-    OHLCV() : open(0), high(0), low(0), close(0), volume(0) {}
-    OHLCV(double o, double h, double l, double c, long long v) 
+    OHLCV() : volume(0) {}
+    OHLCV(Price o, Price h, Price l, Price c, Quantity v) 
         : open(o), high(h), low(l), close(c), volume(v), 
           timestamp(std::chrono::system_clock::now()) {}
 };
 
+// Read-only contiguous view over candles (vector, ring buffer window, ...)
+using CandleSpan = Span<const OHLCV>;
+
 /**
- * Real-time stock data with live metrics
+ * Candlestick patterns detected on one bar, one bit each (see PatternScanner)
  */
-struct StockData {
+using PatternMask = std::uint8_t;
+
+namespace CandlePattern {
+    constexpr PatternMask NONE = 0;
+    constexpr PatternMask DOJI = 1u << 0;
+    constexpr PatternMask HAMMER = 1u << 1;
+    constexpr PatternMask SHOOTING_STAR = 1u << 2;
+    constexpr PatternMask BULLISH_ENGULFING = 1u << 3;
+    constexpr PatternMask BEARISH_ENGULFING = 1u << 4;
+
+    constexpr PatternMask BULLISH_REVERSAL = HAMMER | BULLISH_ENGULFING;
+    constexpr PatternMask BEARISH_REVERSAL = SHOOTING_STAR | BEARISH_ENGULFING;
+}
+
+/**
+ * Cold per-symbol metadata, only needed for display and export
+ */
+struct StockInfo {
     std::string symbol;
     std::string name;
-    double current_price;
-    double previous_close;
-    double change;
-    double change_percent;
-    long long volume;
-    long long avg_volume;
-    double volume_ratio;
     double market_cap;
-    double day_high;
-    double day_low;
     std::chrono::system_clock::time_point last_update;
     
+    StockInfo() : market_cap(0) {}
+};
+
+/**
+ * Outcome of the streaming anomaly check on a symbol's newest bar
+ * (see AnomalyMonitor)
+ */
+enum class AnomalyType : std::uint8_t {
+    NONE,
+    BAD_PRINT,      // quarantined: kept out of bars, indicators and strategies
+    PRICE_SHOCK,    // real move far outside the recent return distribution
+    VOLUME_SHOCK    // volume far outside the recent distribution
+};
+
+/**
+ * Real-time stock data with live metrics.
+ * Hot record: only the fields scans and strategies touch, no owning strings.
+ */
+struct StockData {
+    SymbolId symbol_id;
+    Price current_price;
+    Price previous_close;
+    Price change;
+    double change_percent;
+    Quantity volume;
+    Quantity avg_volume;
+    double volume_ratio;
+    Price day_high;
+    Price day_low;
+    
     // Technical indicators
     double rsi_14;
+    double rsi_14_15m;         // RSI(14) of 15m bars rolled up from the 1m series
     double sma_20;
     double sma_50;
     double ema_9;
     double ema_21;
     double vwap;
+    double vwap_std_dev;       // volume-weighted sigma around the session VWAP
     double atr_14;
     double bollinger_upper;
     double bollinger_lower;
-    double support_level;
-    double resistance_level;
+    double macd_line;          // EMA(12) - EMA(26) of daily closes
+    double macd_signal;        // EMA(9) of the MACD line
+    double macd_histogram;     // line - signal; > 0 when momentum is rising
+    Price support_level;
+    Price resistance_level;
+    Price point_of_control;    // session volume profile, see VolumeProfile
+    Price value_area_low;
+    Price value_area_high;
     
     // Trading metrics
     bool is_breakout;
@@ -64,30 +124,154 @@ struct StockData {
     bool volume_spike;
     bool near_support;
     bool near_resistance;
+    PatternMask candle_patterns;   // CandlePattern bits on the newest completed 1m bar
+    AnomalyType anomaly;           // anomaly of the newest bar of the last fetch
+    double anomaly_z;              // its z-score (return, or volume for VOLUME_SHOCK)
+    bool anomaly_new;              // that bar was first seen (or revised) by the last fetch
     
-    StockData() : current_price(0), previous_close(0), change(0), change_percent(0),
-                  volume(0), avg_volume(0), volume_ratio(1.0), market_cap(0),
-                  day_high(0), day_low(0), rsi_14(50), sma_20(0), sma_50(0),
-                  ema_9(0), ema_21(0), vwap(0), atr_14(0), bollinger_upper(0),
-                  bollinger_lower(0), support_level(0), resistance_level(0),
+    StockData() : symbol_id(INVALID_SYMBOL_ID), change_percent(0),
+                  volume(0), avg_volume(0), volume_ratio(1.0),
+                  rsi_14(50), rsi_14_15m(50), sma_20(0), sma_50(0),
+                  ema_9(0), ema_21(0), vwap(0), vwap_std_dev(0), atr_14(0), bollinger_upper(0),
+                  bollinger_lower(0), macd_line(0), macd_signal(0), macd_histogram(0),
                   is_breakout(false), is_breakdown(false), volume_spike(false),
-                  near_support(false), near_resistance(false) {}
+                  near_support(false), near_resistance(false),
+                  candle_patterns(CandlePattern::NONE), anomaly(AnomalyType::NONE), anomaly_z(0),
+                  anomaly_new(false) {}
+};
+
+/**
+ * Index sector classification (see MarketDataUtils::getNifty50Constituents)
+ */
+enum class Sector : std::uint8_t {
+    FINANCIALS,
+    IT,
+    ENERGY,
+    FMCG,
+    AUTO,
+    METALS,
+    HEALTHCARE,
+    INDUSTRIALS,
+    CONSUMER,
+    MATERIALS,
+    TELECOM,
+    UNCLASSIFIED
+};
+
+constexpr size_t SECTOR_COUNT = static_cast<size_t>(Sector::UNCLASSIFIED) + 1;
+
+/**
+ * Index member with its sector and free-float weight (percent of the index)
+ */
+struct IndexConstituent {
+    const char* symbol;
+    Sector sector;
+    double weight;
+};
+
+/**
+ * Advance/decline of one sector and its weight-averaged change
+ */
+struct SectorBreadth {
+    int advances;
+    int declines;
+    int unchanged;
+    double change_percent;   // free-float weighted, constituents only
+    
+    SectorBreadth() : advances(0), declines(0), unchanged(0), change_percent(0) {}
 };
 
 /**
- * Market scan results for different categories
+ * Index level rebuilt from constituents and market breadth (see MarketBreadthEngine)
+ */
+struct MarketBreadth {
+    double index_value;            // 0 until the index's previous close is known
+    double index_change_percent;
+    int constituents_priced;
+    
+    int advances;
+    int declines;
+    int unchanged;
+    int above_vwap;
+    int with_vwap;                 // stocks with a session VWAP
+    int above_sma_50;
+    int with_sma_50;               // stocks with an SMA(50)
+    std::array<SectorBreadth, SECTOR_COUNT> sectors;
+    
+    MarketBreadth() : index_value(0), index_change_percent(0), constituents_priced(0),
+                      advances(0), declines(0), unchanged(0), above_vwap(0), with_vwap(0),
+                      above_sma_50(0), with_sma_50(0) {}
+    
+    double percentAboveVwap() const { return with_vwap > 0 ? 100.0 * above_vwap / with_vwap : 0.0; }
+    double percentAboveSma50() const { return with_sma_50 > 0 ? 100.0 * above_sma_50 / with_sma_50 : 0.0; }
+};
+
+/**
+ * One fetch of the whole universe: hot records plus parallel cold records
+ */
+struct MarketSnapshot {
+    std::vector<StockData> stocks;
+    std::vector<StockInfo> info;     // info[i] describes stocks[i]
+    std::vector<int> slot_by_id;     // SymbolId -> index into stocks, -1 if absent
+    MarketBreadth breadth;           // index and breadth as of this fetch
+    double daily_cache_hit_rate;     // IndicatorEngine cache hit rates (0-1) as of this fetch
+    double intraday_cache_hit_rate;
+    std::chrono::system_clock::time_point update_time;
+    
+    MarketSnapshot() : daily_cache_hit_rate(0), intraday_cache_hit_rate(0),
+                       update_time(std::chrono::system_clock::now()) {}
+    
+    void add(const StockData& stock, const StockInfo& stock_info) {
+        if (stock.symbol_id >= slot_by_id.size()) slot_by_id.resize(stock.symbol_id + 1, -1);
+        slot_by_id[stock.symbol_id] = static_cast<int>(stocks.size());
+        stocks.push_back(stock);
+        info.push_back(stock_info);
+    }
+    
+    // Index of the symbol in stocks/info, or -1 when absent
+    int indexOf(SymbolId id) const { return id < slot_by_id.size() ? slot_by_id[id] : -1; }
+    size_t size() const { return stocks.size(); }
+    
+    // Approximate heap footprint, for memory budget accounting
+    size_t memoryBytes() const {
+        size_t total = stocks.capacity() * sizeof(StockData) +
+                       info.capacity() * sizeof(StockInfo) +
+                       slot_by_id.capacity() * sizeof(int);
+        for (const auto& stock_info : info) {
+            total += stock_info.symbol.capacity() + stock_info.name.capacity();
+        }
+        return total;
+    }
+};
+
+/**
+ * Market scan results for different categories.
+ * Lists hold indices into the snapshot the scan was built from.
  */
 struct MarketScan {
-    std::vector<StockData> top_gainers;
-    std::vector<StockData> top_losers;
-    std::vector<StockData> high_volume;
-    std::vector<StockData> breakout_candidates;
-    std::vector<StockData> breakdown_candidates;
-    std::vector<StockData> near_support;
-    std::vector<StockData> near_resistance;
+    using Index = std::uint32_t;
+    
+    std::shared_ptr<const MarketSnapshot> snapshot;
+    std::vector<Index> top_gainers;
+    std::vector<Index> top_losers;
+    std::vector<Index> high_volume;
+    std::vector<Index> breakout_candidates;
+    std::vector<Index> breakdown_candidates;
+    std::vector<Index> near_support;
+    std::vector<Index> near_resistance;
     std::chrono::system_clock::time_point scan_time;
     
     MarketScan() : scan_time(std::chrono::system_clock::now()) {}
+    
+    const StockData& stock(Index index) const { return snapshot->stocks[index]; }
+    const StockInfo& info(Index index) const { return snapshot->info[index]; }
+    
+    // Index lists only; the snapshot is accounted by its owner
+    size_t memoryBytes() const {
+        return (top_gainers.capacity() + top_losers.capacity() + high_volume.capacity() +
+                breakout_candidates.capacity() + breakdown_candidates.capacity() +
+                near_support.capacity() + near_resistance.capacity()) * sizeof(Index);
+    }
 };
 
 /**
@@ -125,15 +309,33 @@ struct MarketInfo {
                    status_message("Market Closed") {}
 };
 
+/**
+ * Process-wide symbol interning. Ids are dense, start at 0 and are never
+ * reused, so they can index per-symbol arrays. Thread-safe.
+ */
+namespace SymbolTable {
+    SymbolId intern(const std::string& symbol);
+    SymbolId find(const std::string& symbol);   // INVALID_SYMBOL_ID if unknown
+    const std::string& symbol(SymbolId id);     // reference stays valid for the process lifetime
+    size_t size();
+}
+
 /**
  * Utility functions for market data
  */
 namespace MarketDataUtils {
     // Get Nifty 50 symbols with .NS suffix for Yahoo Finance
     std::vector<std::string> getNifty50Symbols();
+    // Same symbols with sector and approximate free-float weight
+    Span<const IndexConstituent> getNifty50Constituents();
+    const char* sectorToString(Sector sector);
+    
+    // Rank/filter a snapshot into scan categories without copying records
+    MarketScan buildMarketScan(std::shared_ptr<const MarketSnapshot> snapshot, size_t top_n = 10);
     
     // Format price for display
     std::string formatPrice(double price, int decimals = 2);
+    std::string formatPrice(Price price, int decimals = 2);
     
     // Format volume for display
     std::string formatVolume(long long volume);
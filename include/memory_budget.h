@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+/**
+ * Subsystems whose memory is accounted against the budget
+ */
+enum class MemorySubsystem {
+    CANDLES,      // intraday bar store and cached candle history
+    INDICATORS,   // per-cycle analysis arena and indicator state
+    HISTORY,      // signal/setup history
+    GUI           // published market view and table rows
+};
+
+constexpr size_t MEMORY_SUBSYSTEM_COUNT = 4;
+
+/**
+ * Point-in-time copy of the accounted usage
+ */
+struct MemoryBreakdown {
+    std::array<size_t, MEMORY_SUBSYSTEM_COUNT> bytes;
+    size_t limit_bytes;
+
+    MemoryBreakdown() : bytes{}, limit_bytes(0) {}
+
+    size_t total() const;
+    size_t of(MemorySubsystem subsystem) const { return bytes[static_cast<size_t>(subsystem)]; }
+};
+
+/**
+ * Memory budget from [advanced] memory_limit_mb in config.ini.
+ *
+ * Each subsystem reports its own footprint (owner thread computes it, so no
+ * subsystem has to be locked to be measured). Past isNearLimit() each owner
+ * trims its own cold data toward the eviction target: the data thread drops
+ * candles from earlier sessions, the GUI thread the oldest history records.
+ * Only those are evictable; indicator state, scanner matrices and the GUI
+ * are reported but never trimmed. Back under the target, the data thread
+ * restores the trimmed candle capacity. Usage is an estimate of the
+ * containers we own, not process RSS.
+ */
+class MemoryBudget {
+public:
+    explicit MemoryBudget(size_t limit_mb = 512);
+
+    void setLimitMB(size_t limit_mb);
+    size_t limitBytes() const { return limit_bytes_.load(std::memory_order_relaxed); }
+
+    // Replace the subsystem's current footprint
+    void report(MemorySubsystem subsystem, size_t bytes);
+
+    size_t usage(MemorySubsystem subsystem) const;
+    size_t totalUsage() const;
+
+    // Above 90% of the limit: start evicting
+    bool isNearLimit() const;
+    // Bytes to free to get back down to 75% of the limit (0 if already there)
+    size_t bytesOverTarget() const;
+    // Bytes that can be taken back before reaching 75% of the limit
+    size_t bytesUnderTarget() const;
+
+    MemoryBreakdown breakdown() const;
+
+private:
+    std::array<std::atomic<size_t>, MEMORY_SUBSYSTEM_COUNT> usage_;
+    std::atomic<size_t> limit_bytes_;
+
+    static constexpr double HIGH_WATER_FRACTION = 0.90;
+    static constexpr double EVICTION_TARGET_FRACTION = 0.75;
+};
+
+namespace MemoryUtils {
+    std::string subsystemToString(MemorySubsystem subsystem);
+    std::string formatMegabytes(size_t bytes, int decimals = 1);
+    // e.g. "Memory: 41.2/512 MB (candles 36.0, indicators 0.1, history 0.4, gui 4.7)"
+    std::string formatBreakdown(const MemoryBreakdown& breakdown);
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "market_data.h"
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+/**
+ * Live hedge and spread of one pair: log(a) = intercept + hedge_ratio * log(b) + spread
+ */
+struct PairStats {
+    SymbolId a;
+    SymbolId b;
+    double hedge_ratio;
+    double intercept;      // natural log, prices in rupees
+    double spread_sigma;   // residual standard deviation, log units
+    double z_score;        // newest spread over spread_sigma
+
+    // From the last cointegration test of the pair (0 / false until tested)
+    double adf_t;
+    double half_life;      // bars for the spread to close half its distance to the mean
+    bool cointegrated;
+
+    PairStats() : a(INVALID_SYMBOL_ID), b(INVALID_SYMBOL_ID), hedge_ratio(0), intercept(0),
+                  spread_sigma(0), z_score(0), adf_t(0), half_life(0), cointegrated(false) {}
+};
+
+/**
+ * Engle-Granger result for one pair (a < b, a regressed on b)
+ */
+struct CointegrationTest {
+    SymbolId a;
+    SymbolId b;
+    double hedge_ratio;
+    double adf_t;          // ADF(1) t-statistic of the residuals
+    double half_life;      // bars; 0 if the residuals do not revert
+    bool cointegrated;     // adf_t beyond the 5% critical value with a positive hedge
+
+    CointegrationTest() : a(INVALID_SYMBOL_ID), b(INVALID_SYMBOL_ID), hedge_ratio(0), adf_t(0),
+                          half_life(0), cointegrated(false) {}
+};
+
+/**
+ * Rolling hedge ratios and spread z-scores for every pair of symbols, with
+ * a periodic Engle-Granger cointegration test run in the background.
+ *
+ * Log prices are kept relative to each symbol's first close and quantized
+ * to fixed point (LEVEL_SCALE units per 1.0 of log), with their sums and
+ * pairwise cross products in int64 like CorrelationMatrix: a bar adds the
+ * new row and removes the one leaving the window exactly, O(N^2) per bar,
+ * and any pair's OLS hedge ratio, residual sigma and current z-score are
+ * then O(1) from the sums. A missing close (0) carries the symbol's last
+ * level; a pair is ready once both symbols have a full window of closes.
+ *
+ * Every `retest_bars` bars the window is copied and every ready pair is
+ * rerun through OLS and an ADF(1) test on its residuals by `workers`
+ * std::async tasks, each over a contiguous slice of the pairs. update()
+ * picks up the results once all tasks are done, without waiting; a retest
+ * is not started while one is still running.
+ * Not thread-safe: owned and updated by the data thread.
+ */
+class PairsScanner {
+public:
+    static constexpr double LEVEL_SCALE = 1e6;
+    // Engle-Granger critical values, two variables with a constant
+    static constexpr double CRITICAL_T_5 = -3.34;
+    static constexpr double CRITICAL_T_1 = -3.90;
+
+    explicit PairsScanner(size_t symbols = 0, size_t window = 120, size_t retest_bars = 15,
+                          unsigned workers = 0);
+    ~PairsScanner();
+
+    PairsScanner(const PairsScanner&) = delete;
+    PairsScanner& operator=(const PairsScanner&) = delete;
+
+    // Grow to `symbols` lanes, keeping the history of existing lanes
+    void resize(size_t symbols);
+
+    // Absorb one bar close per lane (paise, indexed by SymbolId)
+    void update(Span<const std::int32_t> closes);
+    // Adopt a finished background test, if any; update() already does this
+    void collectTests();
+    // Block until the running test (if any) is adopted (benchmarks, parity checks)
+    void waitForTests();
+
+    bool ready(SymbolId a, SymbolId b) const;
+    // O(1); zeros unless ready(a, b)
+    PairStats pair(SymbolId a, SymbolId b) const;
+    // Last test of the pair, or null if it has not been tested
+    const CointegrationTest* test(SymbolId a, SymbolId b) const;
+
+    // Cointegrated pairs whose live spread is at least `entry_z` from its
+    // mean and reverts within half a window, widest first
+    std::vector<PairStats> opportunities(double entry_z) const;
+
+    size_t size() const { return symbols_; }
+    size_t window() const { return window_; }
+    size_t pairsTested() const { return tests_.size(); }
+    size_t pairsCointegrated() const { return cointegrated_; }
+    std::uint64_t testsCompleted() const { return tests_completed_; }
+    bool testing() const { return !workers_running_.empty(); }
+    size_t memoryBytes() const;
+
+private:
+    struct TestJob {
+        size_t symbols;
+        size_t window;
+        std::vector<std::int64_t> levels;          // window rows of symbols levels, oldest first
+        std::vector<CointegrationTest> results;    // one per ready pair, sorted by (a, b)
+    };
+
+    size_t symbols_;
+    size_t window_;
+    size_t samples_;   // rows in the window, up to window_
+    size_t head_;      // row holding the oldest level
+    size_t retest_bars_;
+    size_t bars_since_test_;
+    unsigned workers_;
+
+    std::vector<double> anchor_log_;      // log of the first close (rupees)
+    std::vector<size_t> seen_;            // closes since the anchor, up to window_
+    std::vector<std::int64_t> last_level_;
+    std::vector<std::int64_t> levels_;    // window_ rows of symbols_ levels
+    std::vector<std::int64_t> sum_;       // per lane
+    std::vector<std::int64_t> cross_;     // symbols_ x symbols_, upper triangle (diagonal = squares)
+    std::vector<std::int64_t> removed_;   // scratch: the row leaving the window
+
+    std::vector<CointegrationTest> tests_;   // last completed test, sorted by (a, b)
+    size_t cointegrated_;
+    std::uint64_t tests_completed_;
+    std::shared_ptr<TestJob> job_;
+    std::vector<std::future<void>> workers_running_;
+
+    std::int64_t crossSum(SymbolId a, SymbolId b) const;
+    void startTests();
+    static void runTests(TestJob& job, size_t begin, size_t end);
+};
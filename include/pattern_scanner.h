@@ -0,0 +1,63 @@
+#pragma once
+
+#include "indicator_batch.h"
+#include "market_data.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Candlestick pattern scanner over the recent bars of a whole universe.
+ *
+ * scan() gathers every symbol's newest `lookback` bars into one flat
+ * structure-of-arrays buffer (open, high, low, close and the previous
+ * bar's open/close, paise) and evaluates every pattern over it in a single
+ * pass, eight bars per instruction with AVX2. The result is one
+ * PatternMask per bar, so a pattern filter is a bit test on masks().
+ *
+ * Each bit matches the corresponding TechnicalIndicators helper (isDoji,
+ * isHammer, isShootingStar, isEngulfing split by direction) on the same
+ * bar. A symbol's oldest scanned bar sees its predecessor when the series
+ * has one; otherwise it cannot be engulfing.
+ * Not thread-safe: owned and updated by the data thread.
+ */
+class PatternScanner {
+public:
+    explicit PatternScanner(size_t lookback = 30, double doji_threshold = 0.001);
+
+    // Scan the newest `lookback` bars of each series (indexed by SymbolId)
+    void scan(const std::vector<CandleSpan>& universe);
+
+    // Oldest-to-newest masks of the last scan, aligned with the scanned bars
+    Span<const PatternMask> masks(SymbolId symbol) const;
+    // Newest scanned bar's mask counting back `bars_back` (0 = newest)
+    PatternMask latest(SymbolId symbol, size_t bars_back = 0) const;
+
+    size_t lookback() const { return lookback_; }
+    size_t size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    size_t barCount() const { return masks_.size(); }
+    size_t memoryBytes() const;
+
+    BatchKernel kernel() const { return kernel_; }
+    // Force a kernel (benchmarks, parity checks); falls back to SCALAR if unsupported
+    void setKernel(BatchKernel kernel);
+
+    static const char* patternName(PatternMask pattern);
+
+private:
+    size_t lookback_;
+    double doji_threshold_;
+    BatchKernel kernel_;
+
+    // One entry per scanned bar, symbols back to back (paise)
+    std::vector<std::int32_t> open_;
+    std::vector<std::int32_t> high_;
+    std::vector<std::int32_t> low_;
+    std::vector<std::int32_t> close_;
+    std::vector<std::int32_t> prev_open_;
+    std::vector<std::int32_t> prev_close_;
+    std::vector<PatternMask> masks_;
+    std::vector<size_t> offsets_;   // symbol i owns [offsets_[i], offsets_[i + 1])
+
+    void scanScalar(size_t begin, size_t end);
+    void scanAVX2();
+};
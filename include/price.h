@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <iosfwd>
+
+/**
+ * Share quantities (volumes, position sizes) are whole numbers of shares
+ */
+using Quantity = long long;
+
+/**
+ * Fixed-point rupee price stored as integer paise.
+ *
+ * 32-bit paise covers prices up to ~2.1 crore rupees per share, well above
+ * the DataValidator::isValidPrice ceiling, while keeping candles compact.
+ * Comparisons are exact; floating point is only used inside indicator math.
+ * Values outside the int32 paise range (garbage quotes) become Price(), the
+ * same as non-finite input, so the validators reject them instead of
+ * seeing a wrapped value.
+ */
+struct Price {
+    std::int32_t paise;
+
+    constexpr Price() : paise(0) {}
+
+    static constexpr Price fromPaise(std::int64_t p) {
+        if (p < INT32_MIN || p > INT32_MAX) return Price();
+        return Price(static_cast<std::int32_t>(p));
+    }
+    static Price fromRupees(double rupees) {
+        double paise = rupees * 100.0;
+        if (!std::isfinite(paise) || paise < INT32_MIN - 0.5 || paise >= INT32_MAX + 0.5) return Price();
+        return Price(static_cast<std::int32_t>(std::llround(paise)));
+    }
+
+    constexpr double toDouble() const { return paise / 100.0; }
+    constexpr bool isZero() const { return paise == 0; }
+    constexpr bool isPositive() const { return paise > 0; }
+
+    // Arithmetic (exact)
+    constexpr Price operator+(Price other) const { return Price(paise + other.paise); }
+    constexpr Price operator-(Price other) const { return Price(paise - other.paise); }
+    constexpr Price operator-() const { return Price(-paise); }
+    constexpr Price operator*(std::int32_t factor) const { return Price(paise * factor); }
+    Price& operator+=(Price other) { paise += other.paise; return *this; }
+    Price& operator-=(Price other) { paise -= other.paise; return *this; }
+
+    // Comparisons (exact)
+    constexpr bool operator==(Price other) const { return paise == other.paise; }
+    constexpr bool operator!=(Price other) const { return paise != other.paise; }
+    constexpr bool operator<(Price other) const { return paise < other.paise; }
+    constexpr bool operator<=(Price other) const { return paise <= other.paise; }
+    constexpr bool operator>(Price other) const { return paise > other.paise; }
+    constexpr bool operator>=(Price other) const { return paise >= other.paise; }
+
+private:
+    constexpr explicit Price(std::int32_t p) : paise(p) {}
+};
+
+static_assert(sizeof(Price) == 4, "Price must stay a 32-bit value");
+
+// Streams as rupees with two decimals (CSV export, console logging)
+std::ostream& operator<<(std::ostream& os, Price price);
+
+/**
+ * Tick-size aware price helpers
+ */
+namespace PriceUtils {
+    // NSE equity tick size for the price band the given price falls in
+    Price tickSizeFor(Price price);
+
+    // Round to the nearest / lower / upper valid tick
+    Price roundToTick(Price price);
+    Price floorToTick(Price price);
+    Price ceilToTick(Price price);
+
+    // Scale a price by a floating factor and snap the result to a valid tick
+    Price scaleToTick(Price price, double factor);
+
+    // Exact relative comparisons expressed in basis points (1 bp = 0.01%)
+    bool isAboveByBps(Price price, Price level, int basis_points);   // price > level * (1 + bps)
+    bool isBelowByBps(Price price, Price level, int basis_points);   // price < level * (1 - bps)
+    bool isWithinBps(Price price, Price level, int basis_points);    // |price - level| < level * bps
+}
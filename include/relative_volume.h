@@ -0,0 +1,68 @@
+#pragma once
+
+#include "market_data.h"
+#include "streaming_indicators.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Time-of-day relative volume (RVOL) for every symbol, indexed by SymbolId.
+ *
+ * From the 1m bars of past sessions each symbol keeps the expected
+ * cumulative volume at every minute of the 09:15-15:30 IST session, so a
+ * mid-morning volume is compared with what the symbol usually trades by
+ * mid-morning, not with a full day. The expected curve is the mean of the
+ * first `sessions` completed sessions, then an exponential average with
+ * weight 1/sessions; a session is folded in when the next one's first bar
+ * arrives. ratio() is O(1): today's cumulative volume over the curve at
+ * the newest bar's minute.
+ *
+ * Bars follow the IntradayBarStore rules (newer pushes, same timestamp
+ * amends, older is ignored); bars outside the session are ignored.
+ * Not thread-safe: owned and updated by the data thread.
+ */
+class RelativeVolumeEngine {
+public:
+    static constexpr int SESSION_MINUTES = 375;   // 09:15 to 15:30 IST
+
+    explicit RelativeVolumeEngine(int sessions = 10);
+
+    void update(SymbolId symbol, const OHLCV& bar);
+    void update(SymbolId symbol, CandleSpan bars);
+
+    // Today's cumulative volume over the expected volume by the same minute;
+    // 1.0 until a whole session has been seen
+    double ratio(SymbolId symbol) const;
+    // Volume usually traded by the newest bar's minute (0 without history)
+    Quantity expectedVolume(SymbolId symbol) const;
+    Quantity sessionVolume(SymbolId symbol) const;
+    int sessionsSeen(SymbolId symbol) const;
+
+    // avg_volume (expected by now), volume_ratio and volume_spike, once a
+    // session has been seen
+    void apply(SymbolId symbol, StockData& stock) const;
+
+    size_t memoryBytes() const;
+
+private:
+    struct Profile {
+        std::array<double, SESSION_MINUTES> expected;   // mean cumulative volume by minute
+        std::array<Quantity, SESSION_MINUTES> today;    // cumulative volume by minute, up to `minute`
+        int sessions;
+        std::chrono::system_clock::time_point session_open;
+        std::chrono::system_clock::time_point newest;   // newest bar absorbed
+        int minute;                                     // its minute of session, -1 before the first
+        Quantity before_newest;                         // cumulative volume before the newest bar
+        Quantity cumulative;
+
+        Profile();
+    };
+
+    int sessions_;
+    std::vector<Profile> profiles_;
+
+    Profile& profileFor(SymbolId symbol);
+    void closeSession(Profile& profile) const;
+};
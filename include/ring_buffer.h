@@ -0,0 +1,95 @@
+#pragma once
+
+#include "span.h"
+#include <vector>
+#include <cstddef>
+
+/**
+ * Fixed-capacity ring buffer with contiguous window views.
+ *
+ * Storage is mirrored (every slot is written twice, at i and i + capacity),
+ * so the newest N elements are always one contiguous run regardless of
+ * wrap-around and can be handed to indicator kernels as a plain Span.
+ * Memory is allocated once in reset(); push/replaceLast never allocate.
+ * resize() reallocates while keeping the newest elements (used to trim
+ * cold history under memory pressure and to restore it afterwards).
+ */
+template <typename T>
+class RingBuffer {
+public:
+    RingBuffer() : capacity_(0), count_(0), head_(0) {}
+    explicit RingBuffer(size_t capacity) : RingBuffer() { reset(capacity); }
+
+    // (Re)allocate for the given capacity and drop all contents
+    void reset(size_t capacity) {
+        storage_.assign(capacity * 2, T());
+        capacity_ = capacity;
+        count_ = 0;
+        head_ = 0;
+    }
+
+    // Reallocate for another capacity, keeping the newest elements that fit
+    void resize(size_t capacity) {
+        if (capacity == capacity_) return;
+
+        Span<const T> kept = window(capacity);
+        std::vector<T> storage(capacity * 2, T());
+        for (size_t i = 0; i < kept.size(); ++i) {
+            storage[i] = kept[i];
+            storage[i + capacity] = kept[i];
+        }
+        storage_.swap(storage);
+        capacity_ = capacity;
+        count_ = kept.size();
+        head_ = (count_ == capacity_) ? 0 : count_;
+    }
+    
+    void clear() {
+        count_ = 0;
+        head_ = 0;
+    }
+
+    // Append, overwriting the oldest element once full
+    void push(const T& value) {
+        if (capacity_ == 0) return;
+        storage_[head_] = value;
+        storage_[head_ + capacity_] = value;
+        head_ = (head_ + 1 == capacity_) ? 0 : head_ + 1;
+        if (count_ < capacity_) ++count_;
+    }
+
+    // Overwrite the newest element (e.g. an in-progress bar)
+    void replaceLast(const T& value) {
+        if (count_ == 0) {
+            push(value);
+            return;
+        }
+        size_t slot = (head_ == 0) ? capacity_ - 1 : head_ - 1;
+        storage_[slot] = value;
+        storage_[slot + capacity_] = value;
+    }
+
+    // Oldest-to-newest view of the newest `count` elements
+    Span<const T> window(size_t count) const {
+        size_t n = count < count_ ? count : count_;
+        if (n == 0) return Span<const T>();
+        return Span<const T>(storage_.data() + head_ + capacity_ - n, n);
+    }
+
+    Span<const T> view() const { return window(count_); }
+
+    const T& front() const { return storage_[head_ + capacity_ - count_]; }
+    const T& back() const { return storage_[(head_ == 0 ? capacity_ : head_) - 1]; }
+
+    size_t size() const { return count_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return count_ == 0; }
+    bool full() const { return count_ == capacity_; }
+    size_t memoryBytes() const { return storage_.capacity() * sizeof(T); }
+
+private:
+    std::vector<T> storage_;
+    size_t capacity_;
+    size_t count_;
+    size_t head_;   // next write slot
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "ring_buffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * Minimum or maximum over the last N values, amortized O(1) per value.
+ *
+ * Keeps a monotonic deque of (index, value) candidates: a new value evicts
+ * every candidate it beats from the back, and candidates older than the
+ * window fall off the front, so the front is always the extreme. The deque
+ * lives in a fixed circular array (it never holds more than N entries).
+ *
+ * amendLast() revises the newest value (an in-progress bar). Moving it in
+ * the winning direction (a rising high for RollingMax, a falling low for
+ * RollingMin) stays O(1); moving it back can resurrect candidates the old
+ * value evicted, so that case rebuilds the deque from the raw window in O(N).
+ */
+template <typename T, typename Better>
+class MonotonicWindow {
+public:
+    explicit MonotonicWindow(size_t window = 20) { reset(window); }
+
+    void reset(size_t window) {
+        window_ = window;
+        entries_.assign(window, Entry());
+        values_.reset(window);
+        front_ = 0;
+        size_ = 0;
+        next_index_ = 0;
+    }
+
+    void push(const T& value) {
+        if (window_ == 0) return;
+        values_.push(value);
+        insert(next_index_++, value);
+    }
+
+    void amendLast(const T& value) {
+        if (size_ == 0) {
+            push(value);
+            return;
+        }
+
+        T previous = values_.back();
+        values_.replaceLast(value);
+
+        if (better_(previous, value)) {
+            rebuild();
+            return;
+        }
+        // The newest value is always the back entry
+        popBack();
+        insert(next_index_ - 1, value);
+    }
+
+    // Extreme of the values in the window (T() before the first push)
+    T value() const { return size_ > 0 ? entries_[front_].value : T(); }
+
+    bool full() const { return values_.full(); }
+    bool empty() const { return size_ == 0; }
+    size_t window() const { return window_; }
+    size_t memoryBytes() const { return entries_.capacity() * sizeof(Entry) + values_.memoryBytes(); }
+
+private:
+    struct Entry {
+        std::uint64_t index;
+        T value;
+
+        Entry() : index(0), value() {}
+        Entry(std::uint64_t i, const T& v) : index(i), value(v) {}
+    };
+
+    std::vector<Entry> entries_;   // circular deque, front_ .. front_ + size_
+    RingBuffer<T> values_;         // raw window, only read when rebuilding
+    size_t window_;
+    size_t front_;
+    size_t size_;
+    std::uint64_t next_index_;
+    Better better_;
+
+    size_t slot(size_t offset) const {
+        size_t position = front_ + offset;
+        return position >= window_ ? position - window_ : position;
+    }
+
+    void popBack() { --size_; }
+
+    void insert(std::uint64_t index, const T& value) {
+        // Drop candidates the new value beats or ties (it outlives them)
+        while (size_ > 0 && !better_(entries_[slot(size_ - 1)].value, value)) {
+            popBack();
+        }
+        // Expire from the front before appending, so the deque never exceeds the window
+        while (size_ > 0 && entries_[front_].index + window_ <= index) {
+            front_ = slot(1);
+            --size_;
+        }
+        entries_[slot(size_)] = Entry(index, value);
+        ++size_;
+    }
+
+    void rebuild() {
+        auto window = values_.view();
+        std::uint64_t first_index = next_index_ - window.size();
+        front_ = 0;
+        size_ = 0;
+        for (size_t i = 0; i < window.size(); ++i) {
+            insert(first_index + i, window[i]);
+        }
+    }
+};
+
+template <typename T>
+using RollingMin = MonotonicWindow<T, std::less<T>>;
+
+template <typename T>
+using RollingMax = MonotonicWindow<T, std::greater<T>>;
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Read-copy-update publication of immutable snapshots from one writer
+ * thread to one reader thread.
+ *
+ * The writer builds a complete snapshot off to the side and swaps it in with
+ * a single atomic exchange; the reader picks up whatever is current. Neither
+ * side takes a lock or waits for the other: the reader pins the snapshot it
+ * is using (a single hazard pointer) and the writer frees retired snapshots
+ * once they are no longer pinned, so the pinned one is only reclaimed after
+ * the reader has moved on. At most two snapshots are ever waiting to be freed.
+ *
+ * std::atomic_load/atomic_store on shared_ptr would be simpler but libstdc++
+ * implements them with a global mutex pool, which is what this avoids.
+ */
+template <typename T>
+class SnapshotChannel {
+public:
+    SnapshotChannel() : current_(nullptr), reader_pin_(nullptr), version_(0) {}
+
+    ~SnapshotChannel() {
+        delete current_.load();
+        for (const T* snapshot : retired_) delete snapshot;
+    }
+
+    SnapshotChannel(const SnapshotChannel&) = delete;
+    SnapshotChannel& operator=(const SnapshotChannel&) = delete;
+
+    // Writer thread: make `snapshot` current and free unpinned old ones
+    void publish(std::unique_ptr<const T> snapshot) {
+        const T* previous = current_.exchange(snapshot.release(), std::memory_order_seq_cst);
+        version_.fetch_add(1, std::memory_order_release);
+
+        if (previous) retired_.push_back(previous);
+        reclaim();
+    }
+
+    // Reader thread: current snapshot (may be null before the first publish).
+    // Stays valid until the reader's next acquire() or release().
+    const T* acquire() {
+        const T* snapshot = current_.load(std::memory_order_seq_cst);
+        for (;;) {
+            reader_pin_.store(snapshot, std::memory_order_seq_cst);
+            // Re-check: if the writer swapped in between, the pin may be stale
+            const T* latest = current_.load(std::memory_order_seq_cst);
+            if (latest == snapshot) return snapshot;
+            snapshot = latest;
+        }
+    }
+
+    void release() { reader_pin_.store(nullptr, std::memory_order_seq_cst); }
+
+    // Bumped on every publish; lets the reader skip work when nothing changed
+    std::uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<const T*> current_;
+    std::atomic<const T*> reader_pin_;
+    std::atomic<std::uint64_t> version_;
+    std::vector<const T*> retired_;   // writer thread only
+
+    void reclaim() {
+        const T* pinned = reader_pin_.load(std::memory_order_seq_cst);
+        retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                                      [pinned](const T* snapshot) {
+                                          if (snapshot == pinned) return false;
+                                          delete snapshot;
+                                          return true;
+                                      }),
+                       retired_.end());
+    }
+};
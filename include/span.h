@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Minimal non-owning view over contiguous elements (C++17 stand-in for std::span).
+ * Implicitly constructible from any container exposing data() and size(),
+ * so existing std::vector call sites keep working.
+ */
+template <typename T>
+class Span {
+public:
+    constexpr Span() : data_(nullptr), size_(0) {}
+    constexpr Span(T* data, size_t size) : data_(data), size_(size) {}
+
+    template <typename Container,
+              typename = std::enable_if_t<std::is_convertible_v<
+                  decltype(std::declval<Container&>().data()), T*>>>
+    constexpr Span(Container& container) : data_(container.data()), size_(container.size()) {}
+
+    constexpr T* data() const { return data_; }
+    constexpr size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+
+    constexpr T& operator[](size_t index) const { return data_[index]; }
+    constexpr T& front() const { return data_[0]; }
+    constexpr T& back() const { return data_[size_ - 1]; }
+
+    constexpr T* begin() const { return data_; }
+    constexpr T* end() const { return data_ + size_; }
+
+    // Sub-views (count is clamped to the available elements)
+    constexpr Span first(size_t count) const { return Span(data_, count < size_ ? count : size_); }
+    constexpr Span last(size_t count) const {
+        size_t n = count < size_ ? count : size_;
+        return Span(data_ + (size_ - n), n);
+    }
+
+private:
+    T* data_;
+    size_t size_;
+};
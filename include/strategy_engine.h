@@ -3,11 +3,48 @@
 #include "market_data.h"
 #include "trading_signal.h"
 #include "technical_indicators.h"
+#include "cycle_arena.h"
 #include <vector>
 #include <memory>
 #include <map>
 #include <functional>
 
+class CorrelationMatrix;
+class PairsScanner;
+struct PairStats;
+
+// Per-cycle containers; allocated from the engine's CycleArena
+using SignalList = std::pmr::vector<TradingSignal>;
+using SetupList = std::pmr::vector<TradingSetup>;
+
+/**
+ * Heap/arena usage of one analysis cycle
+ */
+struct AnalysisCycleStats {
+    size_t stocks_analyzed;
+    size_t signals_generated;
+    size_t setups_generated;
+    size_t arena_bytes;
+    std::uint64_t heap_allocations;   // only counted with HFT_TRACK_ALLOCATIONS
+    std::uint64_t heap_bytes;
+
+    AnalysisCycleStats() : stocks_analyzed(0), signals_generated(0), setups_generated(0),
+                          arena_bytes(0), heap_allocations(0), heap_bytes(0) {}
+};
+
+/**
+ * A price or volume shock on a symbol, escalated ahead of regular signals
+ */
+struct AnomalyAlert {
+    SymbolId symbol;
+    AnomalyType type;   // PRICE_SHOCK or VOLUME_SHOCK
+    double z_score;
+    Price price;
+    double change_percent;
+    
+    AnomalyAlert() : symbol(INVALID_SYMBOL_ID), type(AnomalyType::NONE), z_score(0), change_percent(0) {}
+};
+
 /**
  * Base Strategy Interface
  */
@@ -17,8 +54,9 @@ public:
         : strategy_name_(name), strategy_type_(type) {}
     virtual ~BaseStrategy() = default;
     
-    virtual std::vector<TradingSignal> analyze(const StockData& stock, 
-                                             const HistoricalData& historical) = 0;
+    // Append any signals for this stock to `out`
+    virtual void analyze(const StockData& stock, const HistoricalData& historical,
+                         SignalList& out) = 0;
     virtual bool isApplicable(const StockData& stock) const = 0;
     virtual double getMinConfidenceThreshold() const = 0;
     
@@ -37,19 +75,19 @@ class ORBStrategy : public BaseStrategy {
 public:
     ORBStrategy() : BaseStrategy("Opening Range Breakout", StrategyType::ORB) {}
     
-    std::vector<TradingSignal> analyze(const StockData& stock, 
-                                     const HistoricalData& historical) override;
+    void analyze(const StockData& stock, const HistoricalData& historical,
+                 SignalList& out) override;
     bool isApplicable(const StockData& stock) const override;
     double getMinConfidenceThreshold() const override { return 0.6; }
     
 private:
     struct ORBLevels {
-        double orb_high;
-        double orb_low;
-        double range_size;
+        Price orb_high;
+        Price orb_low;
+        Price range_size;
         bool is_valid;
         
-        ORBLevels() : orb_high(0), orb_low(0), range_size(0), is_valid(false) {}
+        ORBLevels() : is_valid(false) {}
     };
     
     ORBLevels calculateORBLevels(const HistoricalData& historical, int minutes = 15);
@@ -63,8 +101,8 @@ class VWAPStrategy : public BaseStrategy {
 public:
     VWAPStrategy() : BaseStrategy("VWAP", StrategyType::VWAP) {}
     
-    std::vector<TradingSignal> analyze(const StockData& stock, 
-                                     const HistoricalData& historical) override;
+    void analyze(const StockData& stock, const HistoricalData& historical,
+                 SignalList& out) override;
     bool isApplicable(const StockData& stock) const override;
     double getMinConfidenceThreshold() const override { return 0.55; }
     
@@ -81,8 +119,8 @@ class RSIStrategy : public BaseStrategy {
 public:
     RSIStrategy() : BaseStrategy("RSI", StrategyType::RSI) {}
     
-    std::vector<TradingSignal> analyze(const StockData& stock, 
-                                     const HistoricalData& historical) override;
+    void analyze(const StockData& stock, const HistoricalData& historical,
+                 SignalList& out) override;
     bool isApplicable(const StockData& stock) const override;
     double getMinConfidenceThreshold() const override { return 0.65; }
     
@@ -99,8 +137,8 @@ class BreakoutStrategy : public BaseStrategy {
 public:
     BreakoutStrategy() : BaseStrategy("Breakout", StrategyType::BREAKOUT) {}
     
-    std::vector<TradingSignal> analyze(const StockData& stock, 
-                                     const HistoricalData& historical) override;
+    void analyze(const StockData& stock, const HistoricalData& historical,
+                 SignalList& out) override;
     bool isApplicable(const StockData& stock) const override;
     double getMinConfidenceThreshold() const override { return 0.7; }
     
@@ -117,8 +155,8 @@ class VolumeStrategy : public BaseStrategy {
 public:
     VolumeStrategy() : BaseStrategy("Volume Spike", StrategyType::VOLUME_SPIKE) {}
     
-    std::vector<TradingSignal> analyze(const StockData& stock, 
-                                     const HistoricalData& historical) override;
+    void analyze(const StockData& stock, const HistoricalData& historical,
+                 SignalList& out) override;
     bool isApplicable(const StockData& stock) const override;
     double getMinConfidenceThreshold() const override { return 0.6; }
     
@@ -128,6 +166,35 @@ private:
     double calculateVolumeStrength(const StockData& stock);
 };
 
+/**
+ * Pairs Strategy: fade a cointegrated pair's spread back to its mean.
+ * Reads two stocks at once, so it is driven by StrategyEngine::analyzePairs
+ * rather than the per-stock BaseStrategy interface.
+ */
+class PairsStrategy {
+public:
+    explicit PairsStrategy(double entry_z = 2.0, double stop_z = 4.0)
+        : strategy_name_("Pairs"), entry_z_(entry_z), stop_z_(stop_z) {}
+    
+    // Two legs, `a` first: buy the cheap side, sell the rich side. The
+    // spread is re-read at the current prices; targets are each leg's price
+    // at a zero spread and stops at `stop_z`, the other leg held where it is.
+    void analyze(const PairStats& pair, const StockData& a, const StockData& b,
+                 SignalList& out) const;
+    double getMinConfidenceThreshold() const { return 0.6; }
+    double getEntryZ() const { return entry_z_; }
+    
+    const std::string& getName() const { return strategy_name_; }
+    StrategyType getType() const { return StrategyType::PAIRS; }
+    
+private:
+    std::string strategy_name_;
+    double entry_z_;
+    double stop_z_;
+    
+    double calculatePairConfidence(const PairStats& pair, double z_score) const;
+};
+
 /**
  * Main Strategy Engine
  */
@@ -142,11 +209,26 @@ public:
     void enableStrategy(const std::string& name);
     void disableStrategy(const std::string& name);
     
-    // Analysis methods
-    std::vector<TradingSignal> analyzeStock(const StockData& stock, 
-                                           const HistoricalData& historical);
-    std::vector<TradingSetup> generateSetups(const std::vector<StockData>& stocks,
-                                           const std::map<std::string, HistoricalData>& historical_data);
+    // Analysis cycle: beginCycle() releases everything the previous cycle
+    // allocated from cycleResource()
+    void beginCycle();
+    std::pmr::memory_resource* cycleResource() { return cycle_arena_.resource(); }
+    
+    // Analysis methods. A stock whose newest bar was quarantined as a bad
+    // print gets no signals; a shocked stock is also queued as an alert.
+    void analyzeStock(const StockData& stock, const HistoricalData& historical,
+                      SignalList& out);
+    // Alerts queued since the last call, oldest first
+    std::vector<AnomalyAlert> takeAlerts();
+    // Append a two-leg setup for each pair whose spread is stretched, widest
+    // first, using each symbol in at most one pair (within the current cycle)
+    void analyzePairs(const PairsScanner& pairs, const MarketSnapshot& snapshot,
+                      std::vector<TradingSetup>& setups);
+    // Runs a full cycle; the result is valid until the next cycle begins
+    const SetupList& generateSetups(const std::vector<StockData>& stocks,
+                                    const std::map<std::string, HistoricalData>& historical_data);
+    const AnalysisCycleStats& getLastCycleStats() const { return last_cycle_stats_; }
+    size_t memoryBytes() const { return cycle_arena_.capacity(); }
     
     MarketScan generateMarketScan(const std::map<std::string, StockData>& all_stocks,
                                  const std::map<std::string, HistoricalData>& historical_data);
@@ -158,7 +240,8 @@ public:
     
     // Setup generation
     TradingSetup combineSignalsToSetup(const std::string& symbol,
-                                      const std::vector<TradingSignal>& signals);
+                                      Span<const TradingSignal> signals,
+                                      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
     
     // Performance tracking
     void updatePerformanceStats(const TradingSignal& signal, bool was_profitable, 
@@ -169,6 +252,13 @@ public:
     void setGlobalConfidenceThreshold(double threshold);
     void setRiskRewardThreshold(double min_rr_ratio);
     void setMaxSignalsPerStock(int max_signals);
+    void setMaxCorrelation(double limit);
+    
+    // Risk: drop setups that would stack exposure correlated beyond the limit
+    // with a better-ranked setup already kept (`setups` sorted best first);
+    // a pair's legs are netted, its hedge leg weighted by the hedge ratio
+    void filterCorrelatedSetups(std::vector<TradingSetup>& setups,
+                                const CorrelationMatrix& correlations) const;
     
     // Status
     std::vector<std::string> getActiveStrategies() const;
@@ -176,6 +266,7 @@ public:
     
 private:
     std::vector<std::unique_ptr<BaseStrategy>> strategies_;
+    PairsStrategy pairs_strategy_;
     std::map<std::string, bool> strategy_enabled_;
     std::map<StrategyType, SignalPerformance> performance_stats_;
     
@@ -183,10 +274,18 @@ private:
     double global_confidence_threshold_;
     double min_risk_reward_ratio_;
     int max_signals_per_stock_;
+    double max_correlation_;   // [risk_management] max_correlation_limit
+    std::vector<AnomalyAlert> alerts_;
+    
+    // Cycle storage (arena first: it must outlive the containers using it)
+    CycleArena cycle_arena_;
+    SignalList cycle_signals_;
+    SetupList cycle_setups_;
+    AnalysisCycleStats last_cycle_stats_;
     
     // Helper methods
     void initializeDefaultStrategies();
-    double calculateSetupConfidence(const std::vector<TradingSignal>& signals);
+    double calculateSetupConfidence(Span<const TradingSignal> signals);
     bool isHighQualitySetup(const TradingSetup& setup);
     void updateSignalMetrics(TradingSignal& signal, const StockData& stock);
 };
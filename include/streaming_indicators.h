@@ -0,0 +1,577 @@
+#pragma once
+
+#include "fixed_indicators.h"
+#include "intraday_bar_store.h"
+#include "market_data.h"
+#include "ring_buffer.h"
+#include "rolling_extrema.h"
+#include "technical_indicators.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Streaming counterparts of the TechnicalIndicators functions.
+ *
+ * Each indicator absorbs one bar in O(1) with push(), or revises the most
+ * recent bar (an in-progress candle) with amendLast(). Fed the same bars
+ * from the start, value() matches the scalar function on that series,
+ * including its warm-up result (0, or 50 for RSI). The scalar functions
+ * stay the reference implementation.
+ */
+
+/**
+ * Simple moving average of closes. Sums are kept in integer paise,
+ * so adding and removing bars never drifts.
+ */
+class StreamingSMA {
+public:
+    explicit StreamingSMA(int periods = 20);
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    bool ready() const { return closes_.full(); }
+    double value() const;
+    int periods() const { return periods_; }
+    size_t memoryBytes() const { return closes_.memoryBytes(); }
+
+private:
+    RingBuffer<std::int32_t> closes_;
+    int periods_;
+    std::int64_t sum_;
+};
+
+/**
+ * Exponential moving average, seeded with the SMA of the first `periods` closes
+ */
+class StreamingEMA {
+public:
+    explicit StreamingEMA(int periods = 9);
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    bool ready() const { return state_.count >= periods_; }
+    double value() const { return ready() ? state_.ema : 0.0; }
+    int periods() const { return periods_; }
+
+private:
+    struct State {
+        double ema;
+        std::int64_t seed_sum;   // paise, until the first `periods` closes are in
+        int count;
+
+        State() : ema(0), seed_sum(0), count(0) {}
+    };
+
+    State state_;
+    State before_last_;   // state prior to the newest bar, for amendLast
+    int periods_;
+    double alpha_;
+
+    void apply(State& state, Price close) const;
+};
+
+/**
+ * RSI with Wilder's smoothing
+ */
+class StreamingRSI {
+public:
+    explicit StreamingRSI(int periods = 14);
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    bool ready() const { return state_.changes >= periods_; }
+    double value() const;
+    int periods() const { return periods_; }
+    double averageGain() const { return state_.avg_gain; }
+    double averageLoss() const { return state_.avg_loss; }
+    Price previousClose() const { return state_.prev_close; }
+
+private:
+    struct State {
+        Price prev_close;
+        bool has_prev;
+        double avg_gain;
+        double avg_loss;
+        int changes;
+
+        State() : has_prev(false), avg_gain(0), avg_loss(0), changes(0) {}
+    };
+
+    State state_;
+    State before_last_;
+    int periods_;
+
+    void apply(State& state, Price close) const;
+};
+
+/**
+ * Average True Range with Wilder's smoothing
+ */
+class StreamingATR {
+public:
+    explicit StreamingATR(int periods = 14);
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    bool ready() const { return state_.ranges >= periods_; }
+    double value() const { return ready() ? state_.atr : 0.0; }
+    int periods() const { return periods_; }
+    Price previousClose() const { return state_.prev.close; }
+
+private:
+    struct State {
+        OHLCV prev;
+        bool has_prev;
+        double atr;
+        int ranges;
+
+        State() : has_prev(false), atr(0), ranges(0) {}
+    };
+
+    State state_;
+    State before_last_;
+    int periods_;
+
+    void apply(State& state, const OHLCV& bar) const;
+};
+
+/**
+ * Bollinger Bands from running sums of closes and squared closes (paise)
+ */
+class StreamingBollinger {
+public:
+    explicit StreamingBollinger(int periods = 20, double multiplier = 2.0);
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    bool ready() const { return closes_.full(); }
+    BollingerBands value() const;
+    int periods() const { return periods_; }
+    double multiplier() const { return multiplier_; }
+    Span<const std::int32_t> window() const { return closes_.view(); }   // paise, oldest first
+    size_t memoryBytes() const { return closes_.memoryBytes(); }
+
+private:
+    RingBuffer<std::int32_t> closes_;
+    int periods_;
+    double multiplier_;
+    std::int64_t sum_;
+    std::int64_t sum_sq_;
+};
+
+/**
+ * Volume-weighted average price of typical prices since the last reset
+ */
+class StreamingVWAP {
+public:
+    StreamingVWAP();
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+    void reset();
+
+    double value() const { return volume_ > 0 ? price_volume_ / volume_ : 0.0; }
+    Quantity volume() const { return volume_; }
+
+private:
+    double price_volume_;
+    Quantity volume_;
+    double last_price_volume_;   // newest bar's contribution, for amendLast
+    Quantity last_volume_;
+};
+
+/**
+ * VWAP anchored at the session open, with volume-weighted sigma bands.
+ *
+ * Restarts at every 09:15 IST open by default (or another daily anchor
+ * time), or accumulates from one fixed instant set with anchorAt(). Bars
+ * older than the current anchor, pre-open bars included, are ignored.
+ * O(1) per bar from running sums of typical price x volume and its square.
+ */
+class AnchoredVWAP {
+public:
+    // 09:15 IST, as an offset from 00:00 UTC
+    static constexpr std::chrono::minutes SESSION_OPEN_UTC{3 * 60 + 45};
+
+    explicit AnchoredVWAP(std::chrono::minutes daily_anchor = SESSION_OPEN_UTC);
+
+    // Anchor once at `anchor` (an event, a swing low) instead of every open
+    void anchorAt(std::chrono::system_clock::time_point anchor);
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    double value() const { return volume_ > 0 ? price_volume_ / volume_ : 0.0; }
+    double standardDeviation() const;
+    VWAPBands bands() const;
+    Quantity volume() const { return volume_; }
+    std::chrono::system_clock::time_point anchor() const { return anchor_; }
+
+private:
+    std::chrono::minutes daily_anchor_;
+    bool fixed_anchor_;
+    bool anchored_;
+    std::chrono::system_clock::time_point anchor_;
+
+    double price_volume_;
+    double price_sq_volume_;
+    Quantity volume_;
+
+    // Newest bar's contribution, for amendLast
+    bool has_last_;
+    double last_price_volume_;
+    double last_price_sq_volume_;
+    Quantity last_volume_;
+
+    void restart(std::chrono::system_clock::time_point anchor);
+    std::chrono::system_clock::time_point sessionAnchor(std::chrono::system_clock::time_point time) const;
+};
+
+/**
+ * Session volume-at-price histogram with point of control and value area.
+ *
+ * Buckets are a whole number of NSE ticks (PriceUtils::tickSizeFor the
+ * session's first price), about `bucket_bps` of that price wide, and the histogram grows in either direction
+ * as price explores; a bar's volume is spread like calculateVolumeProfile.
+ * The POC is tracked as buckets change, so a bar costs O(buckets it spans);
+ * only an amend that lowers the POC's own bucket rescans the histogram.
+ * levels() grows the value area out from the POC and is cached until the
+ * next bar. Restarts at every 09:15 IST open like AnchoredVWAP.
+ */
+class VolumeProfile {
+public:
+    explicit VolumeProfile(int bucket_bps = 5, double value_area = 0.7,
+                           std::chrono::minutes daily_anchor = AnchoredVWAP::SESSION_OPEN_UTC);
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    Price pointOfControl() const { return Price::fromPaise(poc_bucket_ * bucket_paise_); }
+    const VolumeProfileLevels& levels() const;
+    Price bucketSize() const { return Price::fromPaise(bucket_paise_); }
+    Quantity volume() const { return volume_; }
+    size_t bucketCount() const { return volumes_.size(); }
+    size_t memoryBytes() const { return volumes_.capacity() * sizeof(Quantity); }
+
+private:
+    int bucket_bps_;
+    double value_area_;
+    std::chrono::minutes daily_anchor_;
+    bool anchored_;
+    std::chrono::system_clock::time_point anchor_;
+
+    std::int32_t bucket_paise_;          // fixed by the session's first bar
+    std::int32_t first_bucket_;          // volumes_[i] is bucket first_bucket_ + i
+    std::vector<Quantity> volumes_;
+    Quantity volume_;
+    std::int32_t poc_bucket_;
+
+    bool has_last_;
+    OHLCV last_;                         // newest bar, for amendLast
+
+    mutable bool levels_stale_;
+    mutable VolumeProfileLevels levels_;
+
+    void restart(std::chrono::system_clock::time_point anchor);
+    void add(const OHLCV& bar);
+    void remove(const OHLCV& bar);
+    void coverBuckets(std::int32_t low, std::int32_t high);
+};
+
+/**
+ * MACD as a chain of streaming EMAs: fast and slow EMAs of closes and a
+ * signal EMA of their difference, so the signal line needs no MACD history.
+ * Until the signal line is warm it reads as the MACD line (zero histogram).
+ */
+class StreamingMACD {
+public:
+    explicit StreamingMACD(int fast_periods = 12, int slow_periods = 26, int signal_periods = 9);
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    bool ready() const { return signal_.count >= signal_periods_; }
+    MACD value() const;
+
+private:
+    struct SignalState {
+        double ema;
+        double seed_sum;   // until the first signal_periods MACD values are in
+        int count;
+
+        SignalState() : ema(0), seed_sum(0), count(0) {}
+    };
+
+    StreamingEMA fast_;
+    StreamingEMA slow_;
+    SignalState signal_;
+    SignalState before_last_;
+    int signal_periods_;
+    double alpha_;
+
+    void applySignal(SignalState& state) const;
+};
+
+/**
+ * Donchian channel over a rolling window (monotonic deques, amortized O(1))
+ */
+class StreamingDonchian {
+public:
+    explicit StreamingDonchian(int periods = 20);
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    bool ready() const { return lows_.full(); }
+    DonchianChannel value() const;
+    size_t memoryBytes() const { return lows_.memoryBytes() + highs_.memoryBytes(); }
+
+private:
+    RollingMin<Price> lows_;
+    RollingMax<Price> highs_;
+};
+
+/**
+ * Stochastic %K over k_periods bars and its %D average over d_periods
+ */
+class StreamingStochastic {
+public:
+    explicit StreamingStochastic(int k_periods = 14, int d_periods = 3);
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    bool ready() const { return range_.ready(); }
+    StochasticOscillator value() const;
+
+private:
+    StreamingDonchian range_;
+    RingBuffer<double> k_values_;   // newest d_periods %K values
+    int d_periods_;
+};
+
+/**
+ * Williams %R over a rolling window
+ */
+class StreamingWilliamsR {
+public:
+    explicit StreamingWilliamsR(int periods = 14);
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    bool ready() const { return range_.ready(); }
+    double value() const;
+
+private:
+    StreamingDonchian range_;
+    Price last_close_;
+};
+
+/**
+ * Wilder's +DI/-DI and ADX
+ */
+class StreamingDMI {
+public:
+    explicit StreamingDMI(int periods = 14);
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    bool ready() const { return state_.dx_count >= periods_; }   // ADX warm
+    DirectionalMovement value() const;
+
+private:
+    struct State {
+        OHLCV prev;
+        bool has_prev;
+        double smoothed_tr;
+        double smoothed_plus;
+        double smoothed_minus;
+        int changes;
+        double plus_di;
+        double minus_di;
+        double adx;
+        int dx_count;
+
+        State() : has_prev(false), smoothed_tr(0), smoothed_plus(0), smoothed_minus(0), changes(0),
+                  plus_di(0), minus_di(0), adx(0), dx_count(0) {}
+    };
+
+    State state_;
+    State before_last_;
+    int periods_;
+
+    void apply(State& state, const OHLCV& bar) const;
+};
+
+/**
+ * On-balance volume: cumulative volume signed by the close-to-close move
+ */
+class StreamingOBV {
+public:
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    double value() const { return static_cast<double>(state_.obv); }
+
+private:
+    struct State {
+        Quantity obv;
+        Price prev_close;
+        bool has_prev;
+
+        State() : obv(0), has_prev(false) {}
+    };
+
+    State state_;
+    State before_last_;
+
+    static void apply(State& state, const OHLCV& bar);
+};
+
+/**
+ * Session pivots: levels for the current (newest, possibly in-progress) bar
+ * come from the bar before it, so they stay fixed while the bar is amended
+ */
+class StreamingPivots {
+public:
+    StreamingPivots() : bar_count_(0) {}
+
+    void push(const OHLCV& bar);
+    void amendLast(const OHLCV& bar);
+
+    bool ready() const { return bar_count_ >= 2; }
+    const PivotLevels& value() const { return levels_; }
+
+private:
+    OHLCV session_;        // newest bar
+    PivotLevels levels_;   // from the bar before it
+    size_t bar_count_;
+};
+
+/**
+ * The daily indicator set behind StockData, for one symbol. One update()
+ * per bar feeds every indicator, support and resistance included, so
+ * there is no separate pass per indicator. The fixed-period indicators
+ * use the compile-time FixedPeriod kernels.
+ */
+class IndicatorState {
+public:
+    IndicatorState();
+
+    // Same rules as IntradayBarStore::ingest: a newer bar is pushed, a bar
+    // with the latest timestamp amends it, older bars are ignored
+    void update(const OHLCV& bar);
+    void update(CandleSpan bars);
+
+    size_t barCount() const { return bar_count_; }
+    size_t memoryBytes() const;
+
+    // Lowest low / highest high of the last 20 bars
+    Price support() const { return donchian_20.value().lower; }
+    Price resistance() const { return donchian_20.value().upper; }
+
+    // rsi_14, sma_20, sma_50, ema_9, ema_21, atr_14, bollinger_upper/lower,
+    // macd_line/signal/histogram, support_level, resistance_level
+    void apply(StockData& stock) const;
+
+    FixedPeriod::Sma<20> sma_20;
+    FixedPeriod::Sma<50> sma_50;
+    FixedPeriod::Ema<9> ema_9;
+    FixedPeriod::Ema<21> ema_21;
+    FixedPeriod::Rsi<14> rsi_14;
+    FixedPeriod::Atr<14> atr_14;
+    FixedPeriod::Bollinger<20> bollinger_20;
+    StreamingMACD macd;              // 12, 26, 9
+    StreamingDonchian donchian_20;   // support / resistance
+    StreamingDMI dmi_14;
+    StreamingOBV obv;
+    StreamingPivots pivots;
+
+private:
+    std::chrono::system_clock::time_point last_timestamp_;
+    size_t bar_count_;
+};
+
+/**
+ * Hit/miss counts of IndicatorEngine's memoized updates
+ */
+struct IndicatorCacheStats {
+    std::uint64_t hits;
+    std::uint64_t misses;
+
+    IndicatorCacheStats() : hits(0), misses(0) {}
+
+    double hitRate() const {
+        std::uint64_t total = hits + misses;
+        return total > 0 ? static_cast<double>(hits) / total : 0.0;
+    }
+};
+
+/**
+ * Streaming indicators for every symbol, indexed by SymbolId.
+ * Daily indicators come from daily candles; VWAP and its sigma bands come
+ * from the 1m bars, anchored at each 09:15 IST session open, as does the
+ * session volume profile; bars already absorbed are skipped. The 1m, 5m
+ * and 15m sets are fed each timeframe's series as IntradayBarStore rolls
+ * it up from the 1m bars, once per fetch, so every timeframe shares one
+ * fetch.
+ *
+ * Updates are memoized on (symbol, interval, newest bar): when the newest
+ * bar handed in is the one already absorbed, same timestamp and same
+ * OHLCV, nothing is recomputed. A new bar or a revision of the in-progress
+ * bar is a miss, and only the bars from the last one absorbed on are fed.
+ * Each updateDaily/updateTimeframe call counts one hit or miss. The
+ * indicator periods are fixed by IndicatorState's types, so they need no
+ * place in the key.
+ * Not thread-safe: owned and updated by the data thread.
+ */
+class IndicatorEngine {
+public:
+    void updateDaily(SymbolId symbol, CandleSpan bars);
+    void updateIntraday(SymbolId symbol, const OHLCV& bar);
+    // A 1m, 5m or 15m series, oldest first (DAILY is fed by updateDaily)
+    void updateTimeframe(SymbolId symbol, BarInterval interval, CandleSpan bars);
+
+    // Writes the daily set (once warmed up), the session VWAP and sigma,
+    // the session volume profile levels and the 15m RSI
+    void apply(SymbolId symbol, StockData& stock) const;
+
+    const IndicatorState* daily(SymbolId symbol) const;
+    // Indicator set of any timeframe; DAILY is the same as daily()
+    const IndicatorState* timeframe(SymbolId symbol, BarInterval interval) const;
+    VWAPBands sessionVWAP(SymbolId symbol) const;
+    const VolumeProfile* volumeProfile(SymbolId symbol) const;
+    size_t memoryBytes() const;
+
+    const IndicatorCacheStats& dailyCacheStats() const { return daily_cache_; }
+    const IndicatorCacheStats& intradayCacheStats() const { return intraday_cache_; }
+
+private:
+    struct SessionVWAP {
+        AnchoredVWAP vwap;
+        VolumeProfile profile;
+        OHLCV last_bar;
+    };
+
+    struct SymbolState {
+        IndicatorState daily;
+        OHLCV daily_last_bar;   // newest daily bar absorbed, the memo key
+        SessionVWAP session;
+        std::array<IndicatorState, BAR_INTERVAL_COUNT - 1> intraday;   // 1m, 5m, 15m
+        std::array<OHLCV, BAR_INTERVAL_COUNT - 1> intraday_last_bar;
+    };
+
+    std::vector<SymbolState> states_;
+    IndicatorCacheStats daily_cache_;
+    IndicatorCacheStats intraday_cache_;
+
+    SymbolState& stateFor(SymbolId symbol);
+};
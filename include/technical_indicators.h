@@ -28,6 +28,100 @@ struct MACD {
         : macd_line(macd), signal_line(signal), histogram(hist) {}
 };
 
+/**
+ * Stochastic oscillator: %K and its %D moving average (0-100)
+ */
+struct StochasticOscillator {
+    double k;
+    double d;
+    
+    StochasticOscillator() : k(50), d(50) {}
+    StochasticOscillator(double k_value, double d_value) : k(k_value), d(d_value) {}
+};
+
+/**
+ * Donchian channel: highest high and lowest low over a lookback
+ */
+struct DonchianChannel {
+    Price upper;
+    Price lower;
+    
+    DonchianChannel() = default;
+    DonchianChannel(Price u, Price l) : upper(u), lower(l) {}
+    
+    double middle() const { return (upper.toDouble() + lower.toDouble()) / 2.0; }
+};
+
+/**
+ * Wilder's directional movement: +DI, -DI (0-100) and ADX trend strength
+ */
+struct DirectionalMovement {
+    double plus_di;
+    double minus_di;
+    double adx;
+    
+    DirectionalMovement() : plus_di(0), minus_di(0), adx(0) {}
+    DirectionalMovement(double plus, double minus, double adx_value)
+        : plus_di(plus), minus_di(minus), adx(adx_value) {}
+};
+
+/**
+ * Classic floor-trader pivots from one completed session
+ */
+struct PivotLevels {
+    double pivot;
+    double r1, r2, r3;
+    double s1, s2, s3;
+    
+    PivotLevels() : pivot(0), r1(0), r2(0), r3(0), s1(0), s2(0), s3(0) {}
+};
+
+/**
+ * VWAP with volume-weighted standard deviation bands at 1 and 2 sigma
+ */
+struct VWAPBands {
+    double vwap;
+    double std_dev;
+    double upper_1, lower_1;
+    double upper_2, lower_2;
+    
+    VWAPBands() : vwap(0), std_dev(0), upper_1(0), lower_1(0), upper_2(0), lower_2(0) {}
+    VWAPBands(double v, double sd)
+        : vwap(v), std_dev(sd), upper_1(v + sd), lower_1(v - sd), upper_2(v + 2 * sd), lower_2(v - 2 * sd) {}
+};
+
+/**
+ * Volume-at-price levels. Buckets are quoted at their lower bound, so with
+ * one-tick buckets every level is a traded price.
+ */
+struct VolumeProfileLevels {
+    Price point_of_control;   // bucket with the most volume (the lowest on a tie)
+    Price value_area_low;
+    Price value_area_high;
+    Quantity volume;
+    
+    VolumeProfileLevels() : volume(0) {}
+};
+
+/**
+ * The indicator set behind StockData, as calculateIndicatorSet returns it
+ */
+struct IndicatorSet {
+    double rsi_14;
+    double sma_20;
+    double sma_50;
+    double ema_9;
+    double ema_21;
+    double vwap;
+    double atr_14;
+    BollingerBands bollinger;   // 20, 2.0
+    MACD macd;                  // 12, 26, 9
+    Price support;              // lowest low of the last 20 candles
+    Price resistance;           // highest high of the last 20 candles
+    
+    IndicatorSet() : rsi_14(50.0), sma_20(0), sma_50(0), ema_9(0), ema_21(0), vwap(0), atr_14(0) {}
+};
+
 /**
  * Technical Indicators Calculator
  */
@@ -36,31 +130,40 @@ public:
     TechnicalIndicators() = default;
     
     // Moving Averages
-    static double calculateSMA(const std::vector<OHLCV>& data, int periods);
-    static double calculateEMA(const std::vector<OHLCV>& data, int periods);
-    static double calculateWMA(const std::vector<OHLCV>& data, int periods);
+    static double calculateSMA(CandleSpan data, int periods);
+    static double calculateEMA(CandleSpan data, int periods);
+    static double calculateWMA(CandleSpan data, int periods);
     
     // Oscillators
-    static double calculateRSI(const std::vector<OHLCV>& data, int periods = 14);
-    static double calculateStochastic(const std::vector<OHLCV>& data, int k_periods = 14, int d_periods = 3);
-    static double calculateWilliamsR(const std::vector<OHLCV>& data, int periods = 14);
+    static double calculateRSI(CandleSpan data, int periods = 14);
+    static StochasticOscillator calculateStochastic(CandleSpan data, int k_periods = 14, int d_periods = 3);
+    static double calculateWilliamsR(CandleSpan data, int periods = 14);
     
     // Volatility Indicators
-    static double calculateATR(const std::vector<OHLCV>& data, int periods = 14);
-    static BollingerBands calculateBollingerBands(const std::vector<OHLCV>& data, int periods = 20, double multiplier = 2.0);
+    static double calculateATR(CandleSpan data, int periods = 14);
+    static BollingerBands calculateBollingerBands(CandleSpan data, int periods = 20, double multiplier = 2.0);
     
     // Volume Indicators
-    static double calculateVWAP(const std::vector<OHLCV>& data);
-    static double calculateOBV(const std::vector<OHLCV>& data);
+    static double calculateVWAP(CandleSpan data);
+    // VWAP and bands over every candle given (the caller picks the anchor)
+    static VWAPBands calculateVWAPBands(CandleSpan data);
+    static double calculateOBV(CandleSpan data);
+    // Volume-at-price over every candle given; each candle's volume is spread
+    // evenly over the buckets its range touches, the remainder at its close
+    static VolumeProfileLevels calculateVolumeProfile(CandleSpan data, Price bucket_size, double value_area = 0.7);
     
     // Trend Indicators
-    static MACD calculateMACD(const std::vector<OHLCV>& data, int fast_period = 12, int slow_period = 26, int signal_period = 9);
-    static double calculateADX(const std::vector<OHLCV>& data, int periods = 14);
+    static MACD calculateMACD(CandleSpan data, int fast_period = 12, int slow_period = 26, int signal_period = 9);
+    static double calculateADX(CandleSpan data, int periods = 14);
+    static DirectionalMovement calculateDMI(CandleSpan data, int periods = 14);
     
     // Support and Resistance
-    static double findSupport(const std::vector<OHLCV>& data, int lookback = 20);
-    static double findResistance(const std::vector<OHLCV>& data, int lookback = 20);
-    static std::vector<double> findPivotPoints(const std::vector<OHLCV>& data);
+    static Price findSupport(CandleSpan data, int lookback = 20);
+    static Price findResistance(CandleSpan data, int lookback = 20);
+    static DonchianChannel calculateDonchianChannel(CandleSpan data, int periods = 20);
+    // Pivots from the last candle (the most recent completed session), ascending: S3..S1, P, R1..R3
+    static std::vector<double> findPivotPoints(CandleSpan data);
+    static PivotLevels calculatePivotLevels(const OHLCV& session);
     
     // Pattern Recognition
     static bool isDoji(const OHLCV& candle, double threshold = 0.001);
@@ -71,12 +174,53 @@ public:
     // Utility functions
     static double calculateTrueRange(const OHLCV& current, const OHLCV& previous);
     static double calculateTypicalPrice(const OHLCV& candle);
-    static std::vector<double> calculateReturns(const std::vector<OHLCV>& data);
+    // %K and Williams %R of a close within a [lowest, highest] range (50 / -50 if flat)
+    static double stochasticK(Price close, Price lowest, Price highest);
+    static double williamsR(Price close, Price lowest, Price highest);
+    // +DM / -DM of a bar against the previous one (at most one is non-zero)
+    static double plusDirectionalMove(const OHLCV& current, const OHLCV& previous);
+    static double minusDirectionalMove(const OHLCV& current, const OHLCV& previous);
+    // DX from +DI/-DI (0 when both are 0)
+    static double directionalIndex(double plus_di, double minus_di);
+    // POC and the value area grown from it toward the heavier neighbouring bucket
+    // until `value_area` of `total` is inside; volumes[i] is bucket first_bucket + i
+    static VolumeProfileLevels volumeProfileLevels(Span<const Quantity> volumes, std::int32_t first_bucket,
+                                                   std::int32_t poc_bucket, Quantity total,
+                                                   Price bucket_size, double value_area);
+    static std::vector<double> calculateReturns(CandleSpan data);
+    
+    // Full-series variants for charts and backtests: out[i] is what the scalar
+    // function returns for the first i + 1 candles (including its warm-up value),
+    // computed in a single O(n) pass. Writes min(data.size(), out.size()) values.
+    static void calculateSMASeries(CandleSpan data, int periods, Span<double> out);
+    static void calculateEMASeries(CandleSpan data, int periods, Span<double> out);
+    static void calculateWMASeries(CandleSpan data, int periods, Span<double> out);
+    static void calculateRSISeries(CandleSpan data, int periods, Span<double> out);
+    static void calculateATRSeries(CandleSpan data, int periods, Span<double> out);
+    static void calculateBollingerBandsSeries(CandleSpan data, int periods, double multiplier,
+                                              Span<BollingerBands> out);
+    static void calculateVWAPSeries(CandleSpan data, Span<double> out);
+    static void calculateMACDSeries(CandleSpan data, int fast_period, int slow_period, int signal_period,
+                                    Span<MACD> out);
+    static void findSupportSeries(CandleSpan data, int lookback, Span<Price> out);
+    static void findResistanceSeries(CandleSpan data, int lookback, Span<Price> out);
+    static void calculateDonchianSeries(CandleSpan data, int periods, Span<DonchianChannel> out);
+    static void calculateStochasticSeries(CandleSpan data, int k_periods, int d_periods,
+                                          Span<StochasticOscillator> out);
+    static void calculateWilliamsRSeries(CandleSpan data, int periods, Span<double> out);
+    static void calculateOBVSeries(CandleSpan data, Span<double> out);
+    static void calculateDMISeries(CandleSpan data, int periods, Span<DirectionalMovement> out);
+    // out[i] are the pivots from candle i, as findPivotPoints returns them for the first i + 1
+    static void calculatePivotSeries(CandleSpan data, Span<PivotLevels> out);
+    
+    // Every IndicatorSet field in one sweep over the candles; same results as
+    // the individual functions (Bollinger to within rounding)
+    static IndicatorSet calculateIndicatorSet(CandleSpan data);
     
 private:
     // Helper functions
-    static std::vector<double> extractClosePrices(const std::vector<OHLCV>& data);
-    static std::vector<double> extractHighPrices(const std::vector<OHLCV>& data);
-    static std::vector<double> extractLowPrices(const std::vector<OHLCV>& data);
+    static std::vector<double> extractClosePrices(CandleSpan data);
+    static std::vector<double> extractHighPrices(CandleSpan data);
+    static std::vector<double> extractLowPrices(CandleSpan data);
     static double standardDeviation(const std::vector<double>& data, double mean);
 };
@@ -1,9 +1,15 @@
 #pragma once
 
+#include "price.h"
+#include "market_data.h"
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <chrono>
 #include <map>
+#include <memory_resource>
+#include <type_traits>
 
 /**
  * Trading signal types
@@ -40,28 +46,44 @@ enum class StrategyType {
     SUPPORT_RESISTANCE, // Support/Resistance levels
     MOMENTUM,         // Momentum based
     VOLUME_SPIKE,     // Volume based signals
-    REVERSAL          // Reversal patterns
+    REVERSAL,         // Reversal patterns
+    PAIRS             // Cointegrated pair spread reversion
 };
 
 /**
- * Individual trading signal
+ * Why a signal fired; rendered to text by SignalUtils::describeSignal
+ */
+enum class SignalReason : std::uint8_t {
+    NONE,
+    ORB_BREAKOUT,     // params: opening range % of price
+    ORB_BREAKDOWN,    // params: opening range % of price
+    VWAP_BREAKOUT,    // params: distance from VWAP %, volume ratio
+    VWAP_BREAKDOWN,   // params: distance from VWAP %, volume ratio
+    RSI_OVERSOLD,     // params: RSI
+    RSI_OVERBOUGHT,   // params: RSI
+    PRICE_BREAKOUT,   // params: volume ratio
+    VOLUME_SPIKE,     // params: volume ratio, change %
+    PAIR_SPREAD_LOW,  // params: spread z-score, hedge ratio
+    PAIR_SPREAD_HIGH  // params: spread z-score, hedge ratio
+};
+
+/**
+ * Individual trading signal (trivially copyable, safe to memcpy for journaling)
  */
 struct TradingSignal {
-    std::string symbol;
+    SymbolId symbol;
     SignalType type;
     SignalStrength strength;
     StrategyType strategy;
+    SignalReason reason;
+    std::array<double, 2> reason_params;
     
-    double entry_price;
-    double stop_loss;
-    double target_1;
-    double target_2;
+    Price entry_price;
+    Price stop_loss;
+    Price target_1;
+    Price target_2;
     double confidence;
     
-    std::string setup_description;
-    std::string entry_reason;
-    std::string risk_reward_info;
-    
     std::chrono::system_clock::time_point timestamp;
     std::chrono::system_clock::time_point expiry;
     
@@ -71,14 +93,22 @@ struct TradingSignal {
     bool breakout_confirmed;
     bool volume_above_average;
     
-    TradingSignal() : type(SignalType::NEUTRAL), strength(SignalStrength::WEAK),
-                     strategy(StrategyType::ORB), entry_price(0), stop_loss(0),
-                     target_1(0), target_2(0), confidence(0), 
+    TradingSignal() : symbol(INVALID_SYMBOL_ID), type(SignalType::NEUTRAL), strength(SignalStrength::WEAK),
+                     strategy(StrategyType::ORB), reason(SignalReason::NONE), reason_params{{0, 0}},
+                     confidence(0), 
                      timestamp(std::chrono::system_clock::now()),
                      volume_confirmation(0), technical_score(0), 
                      breakout_confirmed(false), volume_above_average(false) {}
+    
+    void setReason(SignalReason code, double param_1 = 0, double param_2 = 0) {
+        reason = code;
+        reason_params = {{param_1, param_2}};
+    }
 };
 
+static_assert(std::is_trivially_copyable<TradingSignal>::value,
+              "TradingSignal is journaled and shared by plain copy");
+
 /**
  * Portfolio of trading signals
  */
@@ -123,19 +153,19 @@ struct TradingSetup {
     std::string symbol;
     std::string setup_name;
     SignalType primary_signal;
-    std::vector<TradingSignal> supporting_signals;
+    std::pmr::vector<TradingSignal> supporting_signals;   // arena-backed inside an analysis cycle
     
     // Entry details
-    double recommended_entry;
-    double stop_loss;
-    double target_1;
-    double target_2;
-    double risk_amount;
-    double potential_reward;
+    Price recommended_entry;
+    Price stop_loss;
+    Price target_1;
+    Price target_2;
+    Price risk_amount;
+    Price potential_reward;
     double risk_reward_ratio;
     
     // Timing
-    std::string best_entry_time;
+    const char* best_entry_time;   // static display text
     int setup_validity_minutes;
     
     // Confidence metrics
@@ -146,9 +176,10 @@ struct TradingSetup {
     
     std::chrono::system_clock::time_point created_at;
     
-    TradingSetup() : primary_signal(SignalType::NEUTRAL), recommended_entry(0),
-                    stop_loss(0), target_1(0), target_2(0), risk_amount(0),
-                    potential_reward(0), risk_reward_ratio(0), setup_validity_minutes(30),
+    TradingSetup() : TradingSetup(std::pmr::get_default_resource()) {}
+    explicit TradingSetup(std::pmr::memory_resource* resource)
+                  : primary_signal(SignalType::NEUTRAL), supporting_signals(resource),
+                    risk_reward_ratio(0), best_entry_time(""), setup_validity_minutes(30),
                     overall_confidence(0), technical_confluence(0),
                     volume_confirmation(false), trend_alignment(false),
                     created_at(std::chrono::system_clock::now()) {}
@@ -189,14 +220,19 @@ namespace SignalUtils {
     std::string signalStrengthToString(SignalStrength strength);
     std::string strategyTypeToString(StrategyType strategy);
     
+    // Display text, built on demand from the reason code and prices
+    const char* signalReasonToString(SignalReason reason);
+    std::string describeSignal(const TradingSignal& signal);
+    std::string formatRiskReward(const TradingSignal& signal);
+    
     SignalType stringToSignalType(const std::string& str);
     SignalStrength stringToSignalStrength(const std::string& str);
     StrategyType stringToStrategyType(const std::string& str);
     
     // Risk management
-    double calculatePositionSize(double account_size, double risk_percentage, 
-                               double entry_price, double stop_loss);
-    double calculateRiskRewardRatio(double entry, double stop_loss, double target);
+    Quantity calculatePositionSize(double account_size, double risk_percentage, 
+                                   Price entry_price, Price stop_loss);
+    double calculateRiskRewardRatio(Price entry, Price stop_loss, Price target);
     
     // Signal validation
     bool isValidSignal(const TradingSignal& signal);
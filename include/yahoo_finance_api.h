@@ -1,6 +1,14 @@
 #pragma once
 
 #include "market_data.h"
+#include "anomaly_detector.h"
+#include "correlation_matrix.h"
+#include "intraday_bar_store.h"
+#include "market_breadth.h"
+#include "pairs_scanner.h"
+#include "pattern_scanner.h"
+#include "relative_volume.h"
+#include "streaming_indicators.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -12,6 +20,9 @@
  */
 class YahooFinanceAPI {
 public:
+    // Daily history long enough to warm up SMA(50) and MACD(26, 9)
+    static const std::string DAILY_HISTORY_RANGE;
+    
     YahooFinanceAPI();
     ~YahooFinanceAPI();
     
@@ -19,17 +30,18 @@ public:
     std::vector<StockData> getQuotes(const std::vector<std::string>& symbols);
     StockData getQuote(const std::string& symbol);
     HistoricalData getHistoricalData(const std::string& symbol, 
-                                    const std::string& period = "1mo",
+                                    const std::string& period = DAILY_HISTORY_RANGE,
                                     const std::string& interval = "1d");
     
     // Async methods
     std::future<std::vector<StockData>> getQuotesAsync(const std::vector<std::string>& symbols);
     std::future<StockData> getQuoteAsync(const std::string& symbol);
     std::future<HistoricalData> getHistoricalDataAsync(const std::string& symbol,
-                                                       const std::string& period = "1mo",
+                                                       const std::string& period = DAILY_HISTORY_RANGE,
                                                        const std::string& interval = "1d");
     
     // Batch operations
+    std::shared_ptr<const MarketSnapshot> getNifty50Snapshot();
     std::map<std::string, StockData> getAllNifty50Data();
     std::future<std::map<std::string, StockData>> getAllNifty50DataAsync();
     
@@ -41,6 +53,19 @@ public:
     void setTimeout(int timeout_seconds);
     void setRetryCount(int retries);
     void setRateLimit(int requests_per_minute);
+    void configureBarStore(const BarStoreConfig& config);
+    
+    // Bounded intraday bars collected from quote fetches
+    const IntradayBarStore& getIntradayBars() const;
+    size_t trimColdBars(size_t bytes_to_free);
+    size_t restoreBarCapacity(size_t bytes_available);
+    const IndicatorEngine& getIndicators() const;
+    const CorrelationMatrix& getCorrelations() const;
+    const PairsScanner& getPairs() const;
+    const PatternScanner& getPatterns() const;
+    const RelativeVolumeEngine& getRelativeVolume() const;
+    const AnomalyMonitor& getAnomalies() const;
+    const MarketBreadthEngine& getMarketBreadth() const;
     
     // Status
     bool isConnected() const;
@@ -54,15 +79,23 @@ private:
                                  const std::string& period,
                                  const std::string& interval);
     
+    // Fetch quotes for the given symbols and append them to the snapshot
+    void fetchQuotes(const std::vector<std::string>& symbols, MarketSnapshot& out);
+    
     // JSON parsing methods
-    std::vector<StockData> parseQuoteResponse(const std::string& json);
-    StockData parseChartResponseForQuote(const std::string& json, const std::string& symbol);
+    void parseQuoteResponse(const std::string& json, MarketSnapshot& out);
+    StockData parseChartResponseForQuote(const std::string& json, const std::string& symbol,
+                                         StockInfo& info);
     StockData parseQuoteData(const std::string& json_object);
     HistoricalData parseHistoricalResponse(const std::string& json);
     
     // Data processing
     void calculateTechnicalIndicators(StockData& stock, const HistoricalData& historical);
     void identifyPatterns(StockData& stock);
+    void updateCorrelations();
+    void updatePatterns(MarketSnapshot& snapshot);
+    void loadVolumeHistory(const std::string& symbol, SymbolId symbol_id);
+    void loadIndexReference();
     
     // Rate limiting
     void enforceRateLimit();
@@ -73,6 +106,19 @@ private:
     int rate_limit_;
     std::chrono::steady_clock::time_point last_request_;
     
+    // Intraday data
+    IntradayBarStore intraday_bars_;
+    IndicatorEngine indicators_;   // streaming, updated per bar
+    CorrelationMatrix correlations_;   // last hour of 1m returns across the universe
+    std::chrono::system_clock::time_point last_correlated_minute_;
+    PairsScanner pairs_;   // hedge ratios and spreads over the last two hours, same minute rows
+    PatternScanner patterns_;   // candlestick masks over each symbol's recent completed 1m bars
+    RelativeVolumeEngine relative_volume_;   // time-of-day volume curves from past sessions' 1m bars
+    std::vector<std::uint8_t> volume_history_loaded_;   // by SymbolId
+    AnomalyMonitor anomalies_;   // screens every 1m bar before it reaches a series
+    MarketBreadthEngine market_breadth_;   // index level and breadth, updated per quote
+    std::chrono::steady_clock::time_point last_index_reference_attempt_;
+    
     // Error handling
     std::string last_error_;
     
@@ -80,6 +126,7 @@ private:
     static const std::string QUOTE_BASE_URL;
     static const std::string HISTORICAL_BASE_URL;
     static const std::string CHART_BASE_URL;
+    static const std::string PRIMARY_INDEX;   // [market] primary_index
 };
 
 /**
@@ -96,6 +143,7 @@ namespace HttpUtils {
  */
 namespace DataValidator {
     bool isValidPrice(double price);
+    bool isValidPrice(Price price);
     bool isValidVolume(long long volume);
     bool isValidSymbol(const std::string& symbol);
     void sanitizeStockData(StockData& data);
@@ -0,0 +1,449 @@
+/**
+ * Indicator benchmark: full-series variants vs recomputing every prefix
+ * with the scalar functions (what a chart or backtest had to do before),
+ * the fused indicator set, and the compile-time FixedPeriod kernels vs the
+ * runtime-period Streaming* classes. Also checks the results agree: the
+ * streaming indicators against the scalar reference, the batch and pattern
+ * kernels against each other and the per-symbol path. Any mismatch makes
+ * it exit non-zero, so `make bench` fails.
+ *
+ * Build and run: make bench
+ */
+#include "fixed_indicators.h"
+#include "indicator_batch.h"
+#include "pattern_scanner.h"
+#include "streaming_indicators.h"
+#include "technical_indicators.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+// Verdict for one parity check; failures make main() return non-zero
+const char* verdict(bool ok) {
+    if (!ok) ++failures;
+    return ok ? "  ✅" : "  ❌";
+}
+
+std::vector<OHLCV> makeCandles(size_t count, unsigned seed = 2024) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> move(0.0, 1.2);
+    std::uniform_int_distribution<int> volume(50000, 500000);
+
+    std::vector<OHLCV> candles;
+    candles.reserve(count);
+    double price = 1500.0;
+    auto start = std::chrono::system_clock::time_point(std::chrono::hours(24 * 20000));
+    for (size_t i = 0; i < count; ++i) {
+        double open = price;
+        price = std::max(10.0, price + move(rng));
+        double high = std::max(open, price) + std::abs(move(rng));
+        double low = std::min(open, price) - std::abs(move(rng));
+        candles.emplace_back(Price::fromRupees(open), Price::fromRupees(high), Price::fromRupees(low),
+                             Price::fromRupees(price), volume(rng));
+        candles.back().timestamp = start + std::chrono::minutes(i);
+    }
+    return candles;
+}
+
+struct BenchCase {
+    const char* name;
+    // Latest value for one prefix of the candles, the scalar way
+    std::function<double(CandleSpan)> scalar;
+    // Whole curve in one pass
+    std::function<void(CandleSpan, std::vector<double>&)> series;
+};
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void runCase(const BenchCase& bench, CandleSpan candles) {
+    std::vector<double> prefix(candles.size());
+    std::vector<double> series(candles.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < candles.size(); ++i) {
+        prefix[i] = bench.scalar(candles.first(i + 1));
+    }
+    double prefix_ms = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    bench.series(candles, series);
+    double series_ms = elapsedMs(start);
+
+    double max_diff = 0.0;
+    for (size_t i = 0; i < candles.size(); ++i) {
+        max_diff = std::max(max_diff, std::abs(prefix[i] - series[i]));
+    }
+
+    std::cout << "  " << std::left << std::setw(12) << bench.name << std::right
+              << std::fixed << std::setprecision(2)
+              << std::setw(12) << prefix_ms << " ms"
+              << std::setw(12) << series_ms << " ms"
+              << std::setw(10) << std::setprecision(0) << prefix_ms / std::max(series_ms, 1e-6) << "x"
+              << "   max diff " << std::scientific << std::setprecision(1) << max_diff
+              << verdict(max_diff < 1e-6) << std::endl;
+}
+
+// The separate calls calculateTechnicalIndicators used to make (plus MACD)
+IndicatorSet separateCalls(CandleSpan data) {
+    using TI = TechnicalIndicators;
+    IndicatorSet set;
+    set.rsi_14 = TI::calculateRSI(data, 14);
+    set.sma_20 = TI::calculateSMA(data, 20);
+    set.sma_50 = TI::calculateSMA(data, 50);
+    set.ema_9 = TI::calculateEMA(data, 9);
+    set.ema_21 = TI::calculateEMA(data, 21);
+    set.vwap = TI::calculateVWAP(data);
+    set.atr_14 = TI::calculateATR(data, 14);
+    set.bollinger = TI::calculateBollingerBands(data, 20, 2.0);
+    set.macd = TI::calculateMACD(data, 12, 26, 9);
+    set.support = TI::findSupport(data, 20);
+    set.resistance = TI::findResistance(data, 20);
+    return set;
+}
+
+double maxDifference(const IndicatorSet& a, const IndicatorSet& b) {
+    return std::max({std::abs(a.rsi_14 - b.rsi_14), std::abs(a.sma_20 - b.sma_20),
+                     std::abs(a.sma_50 - b.sma_50), std::abs(a.ema_9 - b.ema_9),
+                     std::abs(a.ema_21 - b.ema_21), std::abs(a.vwap - b.vwap),
+                     std::abs(a.atr_14 - b.atr_14),
+                     std::abs(a.bollinger.upper - b.bollinger.upper),
+                     std::abs(a.bollinger.lower - b.bollinger.lower),
+                     std::abs(a.macd.histogram - b.macd.histogram),
+                     std::abs((a.support - b.support).toDouble()),
+                     std::abs((a.resistance - b.resistance).toDouble())});
+}
+
+void runFusedCase(CandleSpan candles, int repetitions) {
+    IndicatorSet separate, fused;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        separate = separateCalls(candles);
+    }
+    double separate_us = elapsedMs(start) * 1000.0 / repetitions;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        fused = TechnicalIndicators::calculateIndicatorSet(candles);
+    }
+    double fused_us = elapsedMs(start) * 1000.0 / repetitions;
+
+    double max_diff = maxDifference(separate, fused);
+    std::cout << "  " << std::left << std::setw(12) << candles.size() << std::right
+              << std::fixed << std::setprecision(2)
+              << std::setw(12) << separate_us << " µs"
+              << std::setw(12) << fused_us << " µs"
+              << std::setw(10) << std::setprecision(1) << separate_us / std::max(fused_us, 1e-6) << "x"
+              << "   max diff " << std::scientific << std::setprecision(1) << max_diff
+              << verdict(max_diff < 1e-6) << std::endl;
+}
+
+double indicatorValue(double value) { return value; }
+double indicatorValue(const BollingerBands& bands) { return bands.upper; }
+double indicatorValue(const MACD& macd) { return macd.histogram; }
+double indicatorValue(const DirectionalMovement& dmi) { return dmi.adx; }
+
+// Push every candle through a runtime-period and a fixed-period indicator,
+// reading value() after each bar like the per-bar update does
+template <typename Runtime, typename Fixed>
+void runKernelCase(const char* name, Runtime runtime, Fixed fixed, CandleSpan candles, int repetitions) {
+    double runtime_sum = 0.0, fixed_sum = 0.0, max_diff = 0.0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        Runtime indicator = runtime;
+        for (const auto& candle : candles) {
+            indicator.push(candle);
+            runtime_sum += indicatorValue(indicator.value());
+        }
+    }
+    double runtime_ns = elapsedMs(start) * 1e6 / (static_cast<double>(repetitions) * candles.size());
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        Fixed indicator = fixed;
+        for (const auto& candle : candles) {
+            indicator.push(candle);
+            fixed_sum += indicatorValue(indicator.value());
+        }
+    }
+    double fixed_ns = elapsedMs(start) * 1e6 / (static_cast<double>(repetitions) * candles.size());
+
+    // Separate parity pass so the timed loops stay identical
+    Runtime a = runtime;
+    Fixed b = fixed;
+    for (const auto& candle : candles) {
+        a.push(candle);
+        b.push(candle);
+        max_diff = std::max(max_diff, std::abs(indicatorValue(a.value()) - indicatorValue(b.value())));
+    }
+
+    std::cout << "  " << std::left << std::setw(12) << name << std::right
+              << std::fixed << std::setprecision(2)
+              << std::setw(12) << runtime_ns << " ns"
+              << std::setw(12) << fixed_ns << " ns"
+              << std::setw(10) << std::setprecision(2) << runtime_ns / std::max(fixed_ns, 1e-6) << "x"
+              << "   max diff " << std::scientific << std::setprecision(1) << max_diff
+              << verdict(max_diff == 0.0 && runtime_sum == fixed_sum) << std::endl;
+}
+
+// Each candle goes into a streaming indicator as a provisional bar, then is
+// amended to its final values; after every bar the value must match the
+// scalar function on the same prefix
+template <typename Streaming, typename Scalar>
+void runStreamingCase(const char* name, Streaming indicator, Scalar scalar, CandleSpan candles) {
+    double max_diff = 0.0;
+    for (size_t i = 0; i < candles.size(); ++i) {
+        OHLCV provisional = candles[i];
+        provisional.close = candles[i].open;
+        provisional.volume = candles[i].volume / 2;
+        indicator.push(provisional);
+        indicator.amendLast(candles[i]);
+        max_diff = std::max(max_diff, std::abs(indicatorValue(indicator.value()) - scalar(candles.first(i + 1))));
+    }
+
+    std::cout << "  " << std::left << std::setw(12) << name << std::right
+              << "   max diff " << std::scientific << std::setprecision(1) << max_diff
+              << verdict(max_diff < 1e-9) << std::endl;
+}
+
+// IndicatorBatch with each kernel vs the IndicatorState every lane was
+// seeded from, after every bar close: all must be bit-identical
+void runBatchCase(size_t symbols, size_t bars) {
+    const size_t warmup = 60;
+    std::vector<std::vector<OHLCV>> candles;
+    std::vector<IndicatorState> states(symbols);
+    for (size_t i = 0; i < symbols; ++i) {
+        candles.push_back(makeCandles(warmup + bars, static_cast<unsigned>(i + 1)));
+        states[i].update(CandleSpan(candles[i].data(), warmup));
+    }
+
+    std::vector<BatchKernel> kernels = {BatchKernel::SCALAR};
+    if (IndicatorBatch::bestKernel() == BatchKernel::AVX2) kernels.push_back(BatchKernel::AVX2);
+    std::vector<IndicatorBatch> batches;
+    for (BatchKernel kernel : kernels) {
+        batches.emplace_back(symbols);
+        batches.back().setKernel(kernel);
+        for (size_t i = 0; i < symbols; ++i) batches.back().seed(i, states[i]);
+    }
+
+    double max_diff = 0.0;
+    BarColumn column(symbols);
+    for (size_t b = warmup; b < warmup + bars; ++b) {
+        for (size_t i = 0; i < symbols; ++i) {
+            column.set(i, candles[i][b]);
+            states[i].update(candles[i][b]);
+        }
+        for (auto& batch : batches) {
+            batch.update(column);
+            for (size_t i = 0; i < symbols; ++i) {
+                const auto& state = states[i];
+                max_diff = std::max({max_diff, std::abs(batch.ema9(i) - state.ema_9.value()),
+                                     std::abs(batch.ema21(i) - state.ema_21.value()),
+                                     std::abs(batch.rsi(i) - state.rsi_14.value()),
+                                     std::abs(batch.atr(i) - state.atr_14.value()),
+                                     std::abs(batch.bollinger(i).upper - state.bollinger_20.value().upper),
+                                     std::abs(batch.bollinger(i).lower - state.bollinger_20.value().lower)});
+            }
+        }
+    }
+
+    std::cout << "  " << symbols << " symbols x " << bars << " bars, kernels";
+    for (BatchKernel kernel : kernels) std::cout << " " << IndicatorBatch::kernelName(kernel);
+    std::cout << "   max diff " << std::scientific << std::setprecision(1) << max_diff
+              << verdict(max_diff == 0.0) << std::endl;
+}
+
+// PatternScanner masks with each kernel vs the TechnicalIndicators helpers
+void runPatternCase(size_t symbols, size_t bars) {
+    using TI = TechnicalIndicators;
+    std::vector<std::vector<OHLCV>> candles;
+    std::vector<CandleSpan> universe;
+    for (size_t i = 0; i < symbols; ++i) {
+        // The last symbol is shorter than the lookback; every 7th bar a doji
+        candles.push_back(makeCandles(i + 1 == symbols ? 10 : bars, static_cast<unsigned>(100 + i)));
+        for (size_t k = 0; k < candles.back().size(); k += 7) candles.back()[k].close = candles.back()[k].open;
+    }
+    for (const auto& series : candles) universe.push_back(series);
+
+    std::vector<BatchKernel> kernels = {BatchKernel::SCALAR};
+    if (IndicatorBatch::bestKernel() == BatchKernel::AVX2) kernels.push_back(BatchKernel::AVX2);
+
+    size_t mismatches = 0, flagged = 0;
+    for (BatchKernel kernel : kernels) {
+        PatternScanner scanner(30);
+        scanner.setKernel(kernel);
+        scanner.scan(universe);
+        for (SymbolId s = 0; s < symbols; ++s) {
+            auto masks = scanner.masks(s);
+            size_t first = candles[s].size() - masks.size();
+            for (size_t k = 0; k < masks.size(); ++k) {
+                const OHLCV& bar = candles[s][first + k];
+                const OHLCV& prev = first + k > 0 ? candles[s][first + k - 1] : bar;
+                PatternMask expected = CandlePattern::NONE;
+                if (TI::isDoji(bar)) expected |= CandlePattern::DOJI;
+                if (TI::isHammer(bar)) expected |= CandlePattern::HAMMER;
+                if (TI::isShootingStar(bar)) expected |= CandlePattern::SHOOTING_STAR;
+                if (TI::isEngulfing(prev, bar)) {
+                    expected |= bar.close > bar.open ? CandlePattern::BULLISH_ENGULFING
+                                                     : CandlePattern::BEARISH_ENGULFING;
+                }
+                if (masks[k] != expected) ++mismatches;
+                if (expected != CandlePattern::NONE) ++flagged;
+            }
+        }
+    }
+
+    std::cout << "  " << symbols << " symbols, kernels";
+    for (BatchKernel kernel : kernels) std::cout << " " << IndicatorBatch::kernelName(kernel);
+    std::cout << "   " << flagged << " patterns, " << mismatches << " mismatches"
+              << verdict(mismatches == 0 && flagged > 0) << std::endl;
+}
+
+}
+
+int main() {
+    using TI = TechnicalIndicators;
+
+    // Series results come back as structs for BB/MACD; benchmark one component
+    auto bollingerUpper = [](CandleSpan data, std::vector<double>& out) {
+        std::vector<BollingerBands> bands(data.size());
+        TI::calculateBollingerBandsSeries(data, 20, 2.0, bands);
+        for (size_t i = 0; i < bands.size(); ++i) out[i] = bands[i].upper;
+    };
+    auto macdHistogram = [](CandleSpan data, std::vector<double>& out) {
+        std::vector<MACD> macd(data.size());
+        TI::calculateMACDSeries(data, 12, 26, 9, macd);
+        for (size_t i = 0; i < macd.size(); ++i) out[i] = macd[i].histogram;
+    };
+    auto support = [](CandleSpan data, std::vector<double>& out) {
+        std::vector<Price> levels(data.size());
+        TI::findSupportSeries(data, 20, levels);
+        for (size_t i = 0; i < levels.size(); ++i) out[i] = levels[i].toDouble();
+    };
+    auto adx = [](CandleSpan data, std::vector<double>& out) {
+        std::vector<DirectionalMovement> dmi(data.size());
+        TI::calculateDMISeries(data, 14, dmi);
+        for (size_t i = 0; i < dmi.size(); ++i) out[i] = dmi[i].adx;
+    };
+    auto plusDi = [](CandleSpan data, std::vector<double>& out) {
+        std::vector<DirectionalMovement> dmi(data.size());
+        TI::calculateDMISeries(data, 14, dmi);
+        for (size_t i = 0; i < dmi.size(); ++i) out[i] = dmi[i].plus_di;
+    };
+    auto pivotR1 = [](CandleSpan data, std::vector<double>& out) {
+        std::vector<PivotLevels> pivots(data.size());
+        TI::calculatePivotSeries(data, pivots);
+        for (size_t i = 0; i < pivots.size(); ++i) out[i] = pivots[i].r1;
+    };
+    auto stochasticD = [](CandleSpan data, std::vector<double>& out) {
+        std::vector<StochasticOscillator> stochastic(data.size());
+        TI::calculateStochasticSeries(data, 14, 3, stochastic);
+        for (size_t i = 0; i < stochastic.size(); ++i) out[i] = stochastic[i].d;
+    };
+
+    std::vector<BenchCase> cases = {
+        {"SMA(50)", [](CandleSpan d) { return TI::calculateSMA(d, 50); },
+                    [](CandleSpan d, std::vector<double>& o) { TI::calculateSMASeries(d, 50, o); }},
+        {"EMA(21)", [](CandleSpan d) { return TI::calculateEMA(d, 21); },
+                    [](CandleSpan d, std::vector<double>& o) { TI::calculateEMASeries(d, 21, o); }},
+        {"WMA(20)", [](CandleSpan d) { return TI::calculateWMA(d, 20); },
+                    [](CandleSpan d, std::vector<double>& o) { TI::calculateWMASeries(d, 20, o); }},
+        {"RSI(14)", [](CandleSpan d) { return TI::calculateRSI(d, 14); },
+                    [](CandleSpan d, std::vector<double>& o) { TI::calculateRSISeries(d, 14, o); }},
+        {"ATR(14)", [](CandleSpan d) { return TI::calculateATR(d, 14); },
+                    [](CandleSpan d, std::vector<double>& o) { TI::calculateATRSeries(d, 14, o); }},
+        {"BB(20,2)", [](CandleSpan d) { return TI::calculateBollingerBands(d, 20, 2.0).upper; },
+                     bollingerUpper},
+        {"VWAP", [](CandleSpan d) { return TI::calculateVWAP(d); },
+                 [](CandleSpan d, std::vector<double>& o) { TI::calculateVWAPSeries(d, o); }},
+        {"MACD hist", [](CandleSpan d) { return TI::calculateMACD(d).histogram; }, macdHistogram},
+        {"Support(20)", [](CandleSpan d) { return TI::findSupport(d, 20).toDouble(); }, support},
+        {"Stoch %D", [](CandleSpan d) { return TI::calculateStochastic(d, 14, 3).d; }, stochasticD},
+        {"Williams %R", [](CandleSpan d) { return TI::calculateWilliamsR(d, 14); },
+                        [](CandleSpan d, std::vector<double>& o) { TI::calculateWilliamsRSeries(d, 14, o); }},
+        {"ADX(14)", [](CandleSpan d) { return TI::calculateADX(d, 14); }, adx},
+        {"+DI(14)", [](CandleSpan d) { return TI::calculateDMI(d, 14).plus_di; }, plusDi},
+        {"OBV", [](CandleSpan d) { return TI::calculateOBV(d); },
+                [](CandleSpan d, std::vector<double>& o) { TI::calculateOBVSeries(d, o); }},
+        {"Pivot R1", [](CandleSpan d) { return TI::findPivotPoints(d)[4]; }, pivotR1},
+    };
+
+    std::cout << "📊 Indicator series benchmark (prefix recompute vs one pass)\n" << std::endl;
+    for (size_t count : {1000, 5000}) {
+        auto candles = makeCandles(count);
+        std::cout << "🕯️  " << count << " candles" << std::endl;
+        std::cout << "  " << std::left << std::setw(12) << "Indicator" << std::right
+                  << std::setw(15) << "Prefix" << std::setw(15) << "Series"
+                  << std::setw(11) << "Speedup" << std::endl;
+        for (const auto& bench : cases) {
+            runCase(bench, candles);
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "🔗 Indicator set: separate calls vs one fused pass" << std::endl;
+    std::cout << "  " << std::left << std::setw(12) << "Candles" << std::right
+              << std::setw(15) << "Separate" << std::setw(15) << "Fused"
+              << std::setw(11) << "Speedup" << std::endl;
+    for (size_t count : {250, 2500, 10000}) {
+        auto candles = makeCandles(count);
+        runFusedCase(candles, static_cast<int>(2000000 / count));
+    }
+
+    std::cout << "\n⚙️  Per-bar update: runtime period vs compile-time period (per bar)" << std::endl;
+    std::cout << "  " << std::left << std::setw(12) << "Indicator" << std::right
+              << std::setw(15) << "Runtime" << std::setw(15) << "Fixed"
+              << std::setw(11) << "Speedup" << std::endl;
+    {
+        auto candles = makeCandles(250);
+        const int repetitions = 4000;
+        runKernelCase("SMA(20)", StreamingSMA(20), FixedPeriod::Sma<20>(), candles, repetitions);
+        runKernelCase("SMA(50)", StreamingSMA(50), FixedPeriod::Sma<50>(), candles, repetitions);
+        runKernelCase("EMA(9)", StreamingEMA(9), FixedPeriod::Ema<9>(), candles, repetitions);
+        runKernelCase("EMA(21)", StreamingEMA(21), FixedPeriod::Ema<21>(), candles, repetitions);
+        runKernelCase("RSI(14)", StreamingRSI(14), FixedPeriod::Rsi<14>(), candles, repetitions);
+        runKernelCase("ATR(14)", StreamingATR(14), FixedPeriod::Atr<14>(), candles, repetitions);
+        runKernelCase("BB(20,2)", StreamingBollinger(20, 2.0), FixedPeriod::Bollinger<20>(), candles, repetitions);
+    }
+
+    std::cout << "\n🌊 Streaming vs scalar reference (per bar, through amendLast)" << std::endl;
+    {
+        auto candles = makeCandles(300);
+        runStreamingCase("SMA(20)", StreamingSMA(20), [](CandleSpan d) { return TI::calculateSMA(d, 20); }, candles);
+        runStreamingCase("EMA(21)", StreamingEMA(21), [](CandleSpan d) { return TI::calculateEMA(d, 21); }, candles);
+        runStreamingCase("RSI(14)", StreamingRSI(14), [](CandleSpan d) { return TI::calculateRSI(d, 14); }, candles);
+        runStreamingCase("ATR(14)", StreamingATR(14), [](CandleSpan d) { return TI::calculateATR(d, 14); }, candles);
+        runStreamingCase("BB(20,2)", StreamingBollinger(20, 2.0),
+                         [](CandleSpan d) { return TI::calculateBollingerBands(d, 20, 2.0).upper; }, candles);
+        runStreamingCase("VWAP", StreamingVWAP(), [](CandleSpan d) { return TI::calculateVWAP(d); }, candles);
+        runStreamingCase("MACD hist", StreamingMACD(),
+                         [](CandleSpan d) { return TI::calculateMACD(d).histogram; }, candles);
+        runStreamingCase("ADX(14)", StreamingDMI(14), [](CandleSpan d) { return TI::calculateADX(d, 14); }, candles);
+        runStreamingCase("OBV", StreamingOBV(), [](CandleSpan d) { return TI::calculateOBV(d); }, candles);
+    }
+
+    std::cout << "\n🧮 Batch kernels vs per-symbol IndicatorState" << std::endl;
+    runBatchCase(37, 200);
+
+    std::cout << "\n🕯️  Pattern scanner kernels vs TechnicalIndicators helpers" << std::endl;
+    runPatternCase(41, 200);
+
+    if (failures > 0) {
+        std::cout << "\n❌ " << failures << " parity check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\n✅ All parity checks passed" << std::endl;
+    return 0;
+}
@@ -27,14 +27,14 @@ void displayStockTable(const std::map<std::string, StockData>& stocks) {
     
     for (const auto& [symbol, stock] : stocks) {
         std::string clean_symbol = symbol.substr(0, symbol.find('.'));
-        std::string change_color = stock.change >= 0 ? "\033[32m" : "\033[31m"; // Green/Red
+        std::string change_color = stock.change >= Price() ? "\033[32m" : "\033[31m"; // Green/Red
         std::string reset_color = "\033[0m";
         
         std::string signal = stock.is_breakout ? "🚀 BUY" : (stock.is_breakdown ? "📉 SELL" : "➖ HOLD");
         
         std::cout << "│ " << std::left << std::setw(10) << clean_symbol 
-                  << " │ " << change_color << std::right << std::setw(8) << std::fixed << std::setprecision(1) << stock.current_price << reset_color
-                  << " │ " << change_color << std::right << std::setw(8) << std::fixed << std::setprecision(2) << stock.change << reset_color
+                  << " │ " << change_color << std::right << std::setw(8) << std::fixed << std::setprecision(1) << stock.current_price.toDouble() << reset_color
+                  << " │ " << change_color << std::right << std::setw(8) << std::fixed << std::setprecision(2) << stock.change.toDouble() << reset_color
                   << " │ " << change_color << std::right << std::setw(8) << std::fixed << std::setprecision(2) << stock.change_percent << "%" << reset_color
                   << " │ " << std::right << std::setw(10) << std::fixed << std::setprecision(0) << stock.volume
                   << " │ " << std::right << std::setw(4) << std::fixed << std::setprecision(0) << stock.rsi_14
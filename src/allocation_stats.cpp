@@ -0,0 +1,84 @@
+#include "allocation_stats.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<std::uint64_t> g_allocations{0};
+    std::atomic<std::uint64_t> g_bytes{0};
+}
+
+#ifdef HFT_TRACK_ALLOCATIONS
+
+namespace {
+    void* countedAlloc(std::size_t size) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(size, std::memory_order_relaxed);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+}
+
+// Plain and nothrow forms only; the over-aligned overloads keep the library
+// defaults (nothing in the app allocates over-aligned types).
+void* operator new(std::size_t size) {
+    void* ptr = countedAlloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    void* ptr = countedAlloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+#endif // HFT_TRACK_ALLOCATIONS
+
+namespace AllocationStats {
+
+    bool isTracking() {
+#ifdef HFT_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    Counters current() {
+        Counters counters;
+        counters.allocations = g_allocations.load(std::memory_order_relaxed);
+        counters.bytes = g_bytes.load(std::memory_order_relaxed);
+        return counters;
+    }
+
+    Counters since(const Counters& start) {
+        Counters now = current();
+        now.allocations -= start.allocations;
+        now.bytes -= start.bytes;
+        return now;
+    }
+}
@@ -0,0 +1,114 @@
+#include "anomaly_detector.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    bool sameBar(const OHLCV& a, const OHLCV& b) {
+        return a.timestamp == b.timestamp && a.close == b.close && a.high == b.high &&
+               a.low == b.low && a.open == b.open && a.volume == b.volume;
+    }
+}
+
+// EwmaStats
+EwmaStats::EwmaStats(int periods)
+    : alpha_(2.0 / (std::max(periods, 1) + 1)), mean_(0), variance_(0), count_(0) {
+}
+
+void EwmaStats::add(double x) {
+    if (count_ == 0) {
+        mean_ = x;
+        variance_ = 0;
+    } else {
+        double diff = x - mean_;
+        double increment = alpha_ * diff;
+        mean_ += increment;
+        variance_ = (1 - alpha_) * (variance_ + diff * increment);
+    }
+    ++count_;
+}
+
+double EwmaStats::zScore(double x, double min_sigma) const {
+    return (x - mean_) / std::max(std::sqrt(variance_), min_sigma);
+}
+
+// StreamingAnomalyDetector
+StreamingAnomalyDetector::StreamingAnomalyDetector(int periods, double alert_z, double bad_print_z)
+    : alert_z_(alert_z), bad_print_z_(bad_print_z), state_(periods), before_last_(periods) {
+}
+
+AnomalyCheck StreamingAnomalyDetector::push(const OHLCV& bar) {
+    before_last_ = state_;
+    return apply(state_, bar);
+}
+
+AnomalyCheck StreamingAnomalyDetector::amendLast(const OHLCV& bar) {
+    state_ = before_last_;
+    return apply(state_, bar);
+}
+
+AnomalyCheck StreamingAnomalyDetector::apply(State& state, const OHLCV& bar) const {
+    AnomalyCheck check;
+    check.fresh = true;
+    if (!bar.close.isPositive()) {
+        check.type = AnomalyType::BAD_PRINT;
+        return check;
+    }
+
+    double log_volume = std::log1p(static_cast<double>(std::max<Quantity>(bar.volume, 0)));
+    if (!state.last_close.isPositive()) {
+        state.last_close = bar.close;
+        state.log_volume.add(log_volume);
+        return check;
+    }
+
+    double change = (bar.close - state.last_close).toDouble() / state.last_close.toDouble();
+    if (state.returns.count() >= MIN_SAMPLES) {
+        check.return_z = state.returns.zScore(change, MIN_RETURN_SIGMA);
+        check.volume_z = state.log_volume.zScore(log_volume, MIN_VOLUME_SIGMA);
+
+        // Far off the distribution with no volume behind it: quarantine,
+        // unless the price has now held there for a few bars
+        if (std::abs(check.return_z) >= bad_print_z_ && check.volume_z < alert_z_ &&
+            state.quarantine_run < MAX_QUARANTINE_RUN) {
+            ++state.quarantine_run;
+            check.type = AnomalyType::BAD_PRINT;
+            return check;
+        }
+
+        if (std::abs(check.return_z) >= alert_z_) {
+            check.type = AnomalyType::PRICE_SHOCK;
+        } else if (check.volume_z >= alert_z_) {
+            check.type = AnomalyType::VOLUME_SHOCK;
+        }
+    }
+
+    state.quarantine_run = 0;
+    state.returns.add(change);
+    state.log_volume.add(log_volume);
+    state.last_close = bar.close;
+    return check;
+}
+
+// AnomalyMonitor
+AnomalyCheck AnomalyMonitor::check(SymbolId symbol, const OHLCV& bar) {
+    if (symbol >= symbols_.size()) {
+        symbols_.resize(static_cast<size_t>(symbol) + 1);
+    }
+
+    auto& state = symbols_[symbol];
+    if (state.has_bar) {
+        if (bar.timestamp < state.last_bar.timestamp) return AnomalyCheck();
+        if (sameBar(bar, state.last_bar)) {
+            AnomalyCheck repeated = state.last_check;
+            repeated.fresh = false;
+            return repeated;
+        }
+    }
+
+    bool amend = state.has_bar && bar.timestamp == state.last_bar.timestamp;
+    AnomalyCheck result = amend ? state.detector.amendLast(bar) : state.detector.push(bar);
+    state.last_bar = bar;
+    state.last_check = result;
+    state.has_bar = true;
+    return result;
+}
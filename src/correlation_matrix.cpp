@@ -0,0 +1,150 @@
+#include "correlation_matrix.h"
+#include <algorithm>
+#include <cmath>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define HFT_CORRELATION_AVX2 1
+#include <immintrin.h>
+#endif
+
+CorrelationMatrix::CorrelationMatrix(size_t symbols, size_t window) {
+    reset(symbols, window);
+}
+
+void CorrelationMatrix::reset(size_t symbols, size_t window) {
+    symbols_ = symbols;
+    window_ = std::max<size_t>(window, 2);
+    samples_ = 0;
+    head_ = 0;
+    kernel_ = IndicatorBatch::bestKernel();
+
+    prev_close_.assign(symbols, 0);
+    returns_.assign(window_ * symbols, 0);
+    sum_.assign(symbols, 0);
+    cross_.assign(symbols * symbols, 0);
+    removed_.assign(symbols, 0);
+}
+
+void CorrelationMatrix::resize(size_t symbols) {
+    if (symbols <= symbols_) return;
+
+    // New lanes have an all-zero history, which adds nothing to any sum
+    std::vector<std::int64_t> returns(window_ * symbols, 0);
+    std::vector<std::int64_t> cross(symbols * symbols, 0);
+    for (size_t row = 0; row < window_; ++row) {
+        std::copy_n(returns_.begin() + row * symbols_, symbols_, returns.begin() + row * symbols);
+    }
+    for (size_t i = 0; i < symbols_; ++i) {
+        std::copy_n(cross_.begin() + i * symbols_, symbols_, cross.begin() + i * symbols);
+    }
+
+    returns_.swap(returns);
+    cross_.swap(cross);
+    prev_close_.resize(symbols, 0);
+    sum_.resize(symbols, 0);
+    removed_.resize(symbols, 0);
+    symbols_ = symbols;
+}
+
+void CorrelationMatrix::update(Span<const std::int32_t> closes) {
+    if (symbols_ == 0) return;
+
+    // The oldest row is overwritten in place; keep a copy to subtract
+    std::int64_t* row = returns_.data() + head_ * symbols_;
+    std::copy_n(row, symbols_, removed_.begin());
+
+    for (size_t i = 0; i < symbols_; ++i) {
+        std::int32_t close = i < closes.size() ? closes[i] : 0;
+        std::int64_t quantized = 0;
+        if (close > 0 && prev_close_[i] > 0) {
+            double change = static_cast<double>(close - prev_close_[i]) / prev_close_[i];
+            // Clamped to +/-100% so products stay in _mm256_mul_epi32's 32-bit inputs
+            quantized = std::llround(std::max(-1.0, std::min(1.0, change)) * RETURN_SCALE);
+        }
+        if (close > 0) prev_close_[i] = close;
+
+        row[i] = quantized;
+        sum_[i] += quantized - removed_[i];
+    }
+
+    if (kernel_ == BatchKernel::AVX2) {
+        updateCrossAVX2(row, removed_.data());
+    } else {
+        updateCrossScalar(row, removed_.data());
+    }
+
+    head_ = (head_ + 1 == window_) ? 0 : head_ + 1;
+    if (samples_ < window_) ++samples_;
+}
+
+void CorrelationMatrix::updateCrossScalar(const std::int64_t* added, const std::int64_t* removed) {
+    for (size_t i = 0; i < symbols_; ++i) {
+        std::int64_t a = added[i];
+        std::int64_t r = removed[i];
+        if (a == 0 && r == 0) continue;
+
+        std::int64_t* cross_row = cross_.data() + i * symbols_;
+        for (size_t j = i; j < symbols_; ++j) {
+            cross_row[j] += a * added[j] - r * removed[j];
+        }
+    }
+}
+
+#ifdef HFT_CORRELATION_AVX2
+__attribute__((target("avx2")))
+void CorrelationMatrix::updateCrossAVX2(const std::int64_t* added, const std::int64_t* removed) {
+    for (size_t i = 0; i < symbols_; ++i) {
+        std::int64_t a = added[i];
+        std::int64_t r = removed[i];
+        if (a == 0 && r == 0) continue;
+
+        std::int64_t* cross_row = cross_.data() + i * symbols_;
+        const __m256i a_lanes = _mm256_set1_epi64x(a);
+        const __m256i r_lanes = _mm256_set1_epi64x(r);
+
+        size_t j = i;
+        for (; j + 4 <= symbols_; j += 4) {
+            // _mm256_mul_epi32 multiplies the signed low 32 bits of each lane into 64
+            __m256i add = _mm256_mul_epi32(a_lanes, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(added + j)));
+            __m256i sub = _mm256_mul_epi32(r_lanes, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(removed + j)));
+            __m256i cross = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cross_row + j));
+            cross = _mm256_add_epi64(cross, _mm256_sub_epi64(add, sub));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(cross_row + j), cross);
+        }
+        for (; j < symbols_; ++j) {
+            cross_row[j] += a * added[j] - r * removed[j];
+        }
+    }
+}
+#else
+void CorrelationMatrix::updateCrossAVX2(const std::int64_t* added, const std::int64_t* removed) {
+    updateCrossScalar(added, removed);
+}
+#endif
+
+double CorrelationMatrix::correlation(SymbolId a, SymbolId b) const {
+    if (a >= symbols_ || b >= symbols_ || !ready()) return 0.0;
+
+    size_t i = std::min(a, b);
+    size_t j = std::max(a, b);
+    double n = static_cast<double>(samples_);
+    double sum_i = static_cast<double>(sum_[i]);
+    double sum_j = static_cast<double>(sum_[j]);
+
+    double covariance = n * cross_[i * symbols_ + j] - sum_i * sum_j;
+    double variance_i = n * cross_[i * symbols_ + i] - sum_i * sum_i;
+    double variance_j = n * cross_[j * symbols_ + j] - sum_j * sum_j;
+    if (variance_i <= 0 || variance_j <= 0) return 0.0;
+
+    return std::max(-1.0, std::min(1.0, covariance / std::sqrt(variance_i * variance_j)));
+}
+
+size_t CorrelationMatrix::memoryBytes() const {
+    return prev_close_.capacity() * sizeof(std::int32_t) +
+           (returns_.capacity() + sum_.capacity() + cross_.capacity() + removed_.capacity()) * sizeof(std::int64_t);
+}
+
+void CorrelationMatrix::setKernel(BatchKernel kernel) {
+    kernel_ = (kernel == BatchKernel::AVX2 && IndicatorBatch::bestKernel() != BatchKernel::AVX2)
+                  ? BatchKernel::SCALAR : kernel;
+}
@@ -0,0 +1,37 @@
+#include "cycle_arena.h"
+
+CycleArena::CycleArena(size_t initial_bytes)
+    : buffer_(initial_bytes), tracker_(*this), peak_bytes_(0) {
+    monotonic_.emplace(buffer_.data(), buffer_.size());
+}
+
+void CycleArena::reset() {
+    if (tracker_.bytes_used > peak_bytes_) {
+        peak_bytes_ = tracker_.bytes_used;
+    }
+
+    if (peak_bytes_ > buffer_.size()) {
+        // Last cycle spilled to the heap: grow with headroom so it doesn't again
+        monotonic_.reset();
+        buffer_.assign(peak_bytes_ + peak_bytes_ / 2, std::byte{0});
+        monotonic_.emplace(buffer_.data(), buffer_.size());
+    } else {
+        monotonic_->release();
+    }
+
+    tracker_.bytes_used = 0;
+}
+
+void* CycleArena::TrackingResource::do_allocate(size_t bytes, size_t alignment) {
+    bytes_used += bytes;
+    return arena_.monotonic_->allocate(bytes, alignment);
+}
+
+void CycleArena::TrackingResource::do_deallocate(void* ptr, size_t bytes, size_t alignment) {
+    // No-op for monotonic storage; memory comes back in reset()
+    arena_.monotonic_->deallocate(ptr, bytes, alignment);
+}
+
+bool CycleArena::TrackingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
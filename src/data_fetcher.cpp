@@ -16,7 +16,7 @@ bool DataFetcher::initialize() {
     try {
         // Test API connection
         auto test_quote = api_->getQuote("RELIANCE.NS");
-        if (test_quote.symbol.empty()) {
+        if (test_quote.symbol_id == INVALID_SYMBOL_ID) {
             last_error_ = "Failed to connect to Yahoo Finance API";
             return false;
         }
@@ -120,10 +120,14 @@ void DataFetcher::dataUpdateLoop() {
 
 void DataFetcher::fetchAllData() {
     // Fetch all Nifty 50 data
-    current_data_ = api_->getAllNifty50Data();
+    auto snapshot = api_->getNifty50Snapshot();
+    current_data_.clear();
+    for (size_t i = 0; i < snapshot->size(); ++i) {
+        current_data_[snapshot->info[i].symbol] = snapshot->stocks[i];
+    }
     
-    // Generate market scan
-    current_scan_ = api_->getMarketScan();
+    // Generate market scan from the same snapshot
+    current_scan_ = MarketDataUtils::buildMarketScan(snapshot);
 }
 
 void DataFetcher::notifyDataUpdate() {
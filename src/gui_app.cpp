@@ -3,7 +3,8 @@
 #include <iostream>
 #include <iomanip>
 
-GuiApp::GuiApp() : running_(false), data_update_active_(false) {
+GuiApp::GuiApp() : displayed_view_(nullptr), displayed_version_(0),
+                   running_(false), data_update_active_(false) {
 }
 
 GuiApp::~GuiApp() {
@@ -20,9 +21,12 @@ bool GuiApp::initialize() {
         // Initialize API and data components
         std::cout << "  • Creating Yahoo Finance API..." << std::endl;
         api_ = std::make_unique<YahooFinanceAPI>();
+        api_->configureBarStore(config_.bar_store);
+        memory_budget_.setLimitMB(config_.memory_limit_mb);
         
         std::cout << "  • Creating Strategy Engine..." << std::endl;
         strategy_engine_ = std::make_unique<StrategyEngine>();
+        strategy_engine_->setMaxCorrelation(config_.max_correlation_limit);
         
         std::cout << "  • Creating History Manager..." << std::endl;
         history_manager_ = std::make_unique<HistoryManager>();
@@ -348,6 +352,16 @@ void GuiApp::setupStatusBar() {
     last_update_label_->setTextSize(12);
     status_panel_->add(last_update_label_);
     
+    memory_label_ = tgui::Label::create("Memory: -");
+    memory_label_->setPosition("2%", "60%");
+    memory_label_->setTextSize(10);
+    status_panel_->add(memory_label_);
+    
+    breadth_label_ = tgui::Label::create("NIFTY: -");
+    breadth_label_->setPosition("30%", "60%");
+    breadth_label_->setTextSize(10);
+    status_panel_->add(breadth_label_);
+    
     refresh_button_ = tgui::Button::create("🔄 Refresh");
     refresh_button_->setPosition("60%", "10%");
     refresh_button_->setSize(80, 30);
@@ -392,12 +406,15 @@ void GuiApp::run() {
             }
         }
         
+        // Pick up a newly published data cycle, if any (never blocks the worker)
+        refreshDisplayedView();
+        
         // Update GUI periodically
         static sf::Clock gui_update_clock;
         if (gui_update_clock.getElapsedTime().asSeconds() > 1.0f) {
             updateStatusBar();
             updateMarketStatus();
-            updateLiveDataTable();  // Add this to update the stock table
+            updateMemoryStatus();
             gui_update_clock.restart();
         }
         
@@ -428,6 +445,8 @@ void GuiApp::startDataUpdateThread() {
                 updateMarketData();
                 updateTradingSetups();
                 updateMarketScan();
+                publishMarketView();
+                enforceMemoryBudget();
                 
                 std::this_thread::sleep_for(std::chrono::seconds(config_.update_interval_seconds));
             } catch (const std::exception& e) {
@@ -448,52 +467,133 @@ void GuiApp::stopDataUpdateThread() {
 void GuiApp::updateMarketData() {
     if (!api_) return;
     
-    current_stocks_ = api_->getAllNifty50Data();
+    current_snapshot_ = api_->getNifty50Snapshot();
     last_update_ = std::chrono::system_clock::now();
-    
-    // Update GUI on main thread
-    updateLiveDataTable();
 }
 
 void GuiApp::updateTradingSetups() {
-    if (!strategy_engine_ || current_stocks_.empty()) return;
+    if (!strategy_engine_ || !current_snapshot_ || current_snapshot_->stocks.empty()) return;
     
     current_setups_.clear();
     
-    for (const auto& [symbol, stock] : current_stocks_) {
-        auto historical = api_->getHistoricalData(symbol, "1mo");
-        auto signals = strategy_engine_->analyzeStock(stock, historical);
+    // Signals are cycle-scoped: built in the engine's arena, only the kept
+    // setups are copied out to the heap
+    strategy_engine_->beginCycle();
+    SignalList signals(strategy_engine_->cycleResource());
+    
+    for (size_t i = 0; i < current_snapshot_->size(); ++i) {
+        const auto& stock = current_snapshot_->stocks[i];
+        const auto& symbol = current_snapshot_->info[i].symbol;
+        auto historical = api_->getHistoricalData(symbol, YahooFinanceAPI::DAILY_HISTORY_RANGE);
+        
+        signals.clear();
+        strategy_engine_->analyzeStock(stock, historical, signals);
         
         if (!signals.empty()) {
             auto setup = strategy_engine_->combineSignalsToSetup(symbol, signals);
             if (setup.overall_confidence > 0.5) {
-                current_setups_.push_back(setup);
+                current_setups_.push_back(std::move(setup));
             }
         }
     }
     
-    updateSetupsPanel();
+    strategy_engine_->analyzePairs(api_->getPairs(), *current_snapshot_, current_setups_);
+    
+    // Sort once here so the panel can render without copying
+    std::sort(current_setups_.begin(), current_setups_.end(),
+             [](const TradingSetup& a, const TradingSetup& b) {
+                 return a.overall_confidence > b.overall_confidence;
+             });
+    strategy_engine_->filterCorrelatedSetups(current_setups_, api_->getCorrelations());
+    
+    auto alerts = strategy_engine_->takeAlerts();
+    for (const auto& alert : alerts) {
+        std::ostringstream message;
+        message << (alert.type == AnomalyType::PRICE_SHOCK ? "price" : "volume") << " at "
+                << alert.price << " (" << std::showpos << std::fixed << std::setprecision(2)
+                << alert.change_percent << "%), " << std::noshowpos << std::setprecision(1)
+                << alert.z_score << " sigma";
+        showNotification("⚡ Shock on " + SymbolTable::symbol(alert.symbol), message.str());
+    }
+    if (!alerts.empty() && config_.sound_alerts) playAlertSound();
 }
 
 void GuiApp::updateMarketScan() {
     if (!api_) return;
     
-    current_scan_ = api_->getMarketScan();
+    // Rank the snapshot we already fetched instead of fetching again
+    current_scan_ = MarketDataUtils::buildMarketScan(current_snapshot_);
+}
+
+void GuiApp::publishMarketView() {
+    // Scan and setups are rebuilt every cycle, so hand them over rather than copy
+    auto view = std::make_unique<MarketView>();
+    view->snapshot = current_snapshot_;
+    view->scan = std::move(current_scan_);
+    view->setups = std::move(current_setups_);
+    view->update_time = last_update_;
+    
+    current_scan_ = MarketScan();
+    current_setups_.clear();
+    market_views_.publish(std::move(view));
+}
+
+void GuiApp::enforceMemoryBudget() {
+    memory_budget_.report(MemorySubsystem::CANDLES, api_->getIntradayBars().memoryBytes());
+    memory_budget_.report(MemorySubsystem::INDICATORS,
+                          strategy_engine_->memoryBytes() + api_->getIndicators().memoryBytes() +
+                          api_->getCorrelations().memoryBytes() + api_->getPairs().memoryBytes() +
+                          api_->getPatterns().memoryBytes() + api_->getRelativeVolume().memoryBytes() +
+                          api_->getAnomalies().memoryBytes() + api_->getMarketBreadth().memoryBytes());
+    
+    if (!memory_budget_.isNearLimit()) {
+        // Room again: trimmed symbols get their full bar history back
+        size_t room = memory_budget_.bytesUnderTarget();
+        if (room > 0 && api_->restoreBarCapacity(room) > 0) {
+            memory_budget_.report(MemorySubsystem::CANDLES, api_->getIntradayBars().memoryBytes());
+        }
+        return;
+    }
+    
+    // Only candles are evictable, and only bars from earlier sessions; the
+    // GUI thread trims old history records
+    size_t freed = api_->trimColdBars(memory_budget_.bytesOverTarget());
+    memory_budget_.report(MemorySubsystem::CANDLES, api_->getIntradayBars().memoryBytes());
+    if (freed > 0) {
+        std::cout << "⚠️  Memory budget near limit, trimmed " << MemoryUtils::formatMegabytes(freed)
+                  << " MB of earlier-session candles" << std::endl;
+    }
+}
+
+void GuiApp::refreshDisplayedView() {
+    std::uint64_t version = market_views_.version();
+    if (version == displayed_version_) return;
+    
+    displayed_version_ = version;
+    displayed_view_ = market_views_.acquire();
+    
+    updateLiveDataTable();
+    updateSetupsPanel();
     updateMarketScanLists();
+    updateStatusBar();
 }
 
 void GuiApp::updateLiveDataTable() {
     if (!stocks_table_) return;
     
     stocks_table_->removeAllItems();
+    if (!displayed_view_ || !displayed_view_->snapshot) return;
     
-    for (const auto& [symbol, stock] : current_stocks_) {
+    const MarketSnapshot& snapshot = *displayed_view_->snapshot;
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        const auto& stock = snapshot.stocks[i];
+        const auto& symbol = snapshot.info[i].symbol;
         auto clean_symbol = symbol.substr(0, symbol.find('.'));
         
         std::vector<tgui::String> row = {
             clean_symbol,
-            tgui::String(std::to_string((int)stock.current_price)),
-            tgui::String(MarketDataUtils::formatPercent(stock.change, 2)),
+            tgui::String(MarketDataUtils::formatPrice(stock.current_price)),
+            tgui::String(MarketDataUtils::formatPrice(stock.change)),
             tgui::String(MarketDataUtils::formatPercent(stock.change_percent, 2)),
             tgui::String(MarketDataUtils::formatVolume(stock.volume)),
             tgui::String(std::to_string((int)stock.rsi_14)),
@@ -508,24 +608,21 @@ void GuiApp::updateSetupsPanel() {
     if (!setups_list_) return;
     
     setups_list_->removeAllItems();
+    if (!displayed_view_) return;
     
-    // Sort setups by confidence
-    auto sorted_setups = current_setups_;
-    std::sort(sorted_setups.begin(), sorted_setups.end(),
-             [](const TradingSetup& a, const TradingSetup& b) {
-                 return a.overall_confidence > b.overall_confidence;
-             });
-    
+    // Published setups are already sorted by confidence
     int count = 0;
-    for (const auto& setup : sorted_setups) {
+    for (const auto& setup : displayed_view_->setups) {
         if (count++ >= MAX_SETUPS_DISPLAY) break;
         
-        auto clean_symbol = setup.symbol.substr(0, setup.symbol.find('.'));
+        // Pair setups are labelled with both legs
+        auto clean_symbol = setup.setup_name.empty() ? setup.symbol.substr(0, setup.symbol.find('.'))
+                                                     : setup.setup_name;
         
         std::vector<tgui::String> row = {
             clean_symbol,
             SignalUtils::signalTypeToString(setup.primary_signal),
-            tgui::String(std::to_string((int)setup.recommended_entry)),
+            tgui::String(MarketDataUtils::formatPrice(setup.recommended_entry)),
             tgui::String(std::to_string(setup.risk_reward_ratio).substr(0, 4)),
             tgui::String(std::to_string((int)(setup.overall_confidence * 100)) + "%")
         };
@@ -535,15 +632,20 @@ void GuiApp::updateSetupsPanel() {
 }
 
 void GuiApp::updateMarketScanLists() {
+    if (!displayed_view_) return;
+    const MarketScan& scan = displayed_view_->scan;
+    
     // Update gainers list
     if (gainers_list_) {
         gainers_list_->removeAllItems();
-        for (const auto& stock : current_scan_.top_gainers) {
-            auto clean_symbol = stock.symbol.substr(0, stock.symbol.find('.'));
+        for (auto index : scan.top_gainers) {
+            const auto& stock = scan.stock(index);
+            const auto& symbol = scan.info(index).symbol;
+            auto clean_symbol = symbol.substr(0, symbol.find('.'));
             std::vector<tgui::String> row = {
                 clean_symbol,
                 MarketDataUtils::formatPercent(stock.change_percent, 2),
-                tgui::String(std::to_string((int)stock.current_price))
+                tgui::String(MarketDataUtils::formatPrice(stock.current_price))
             };
             gainers_list_->addItem(row);
         }
@@ -552,12 +654,14 @@ void GuiApp::updateMarketScanLists() {
     // Update losers list
     if (losers_list_) {
         losers_list_->removeAllItems();
-        for (const auto& stock : current_scan_.top_losers) {
-            auto clean_symbol = stock.symbol.substr(0, stock.symbol.find('.'));
+        for (auto index : scan.top_losers) {
+            const auto& stock = scan.stock(index);
+            const auto& symbol = scan.info(index).symbol;
+            auto clean_symbol = symbol.substr(0, symbol.find('.'));
             std::vector<tgui::String> row = {
                 clean_symbol,
                 MarketDataUtils::formatPercent(stock.change_percent, 2),
-                tgui::String(std::to_string((int)stock.current_price))
+                tgui::String(MarketDataUtils::formatPrice(stock.current_price))
             };
             losers_list_->addItem(row);
         }
@@ -566,8 +670,10 @@ void GuiApp::updateMarketScanLists() {
     // Update high volume list
     if (high_volume_list_) {
         high_volume_list_->removeAllItems();
-        for (const auto& stock : current_scan_.high_volume) {
-            auto clean_symbol = stock.symbol.substr(0, stock.symbol.find('.'));
+        for (auto index : scan.high_volume) {
+            const auto& stock = scan.stock(index);
+            const auto& symbol = scan.info(index).symbol;
+            auto clean_symbol = symbol.substr(0, symbol.find('.'));
             std::vector<tgui::String> row = {
                 clean_symbol,
                 MarketDataUtils::formatVolume(stock.volume),
@@ -579,10 +685,70 @@ void GuiApp::updateMarketScanLists() {
 }
 
 void GuiApp::updateStatusBar() {
-    if (last_update_label_) {
-        std::string update_text = "Last Update: " + formatDateTime(last_update_);
+    if (last_update_label_ && displayed_view_) {
+        std::string update_text = "Last Update: " + formatDateTime(displayed_view_->update_time);
         last_update_label_->setText(update_text);
     }
+    
+    if (breadth_label_ && displayed_view_ && displayed_view_->snapshot) {
+        const MarketBreadth& breadth = displayed_view_->snapshot->breadth;
+        
+        // Strongest and weakest sector by weighted change
+        size_t best = 0, worst = 0;
+        for (size_t sector = 1; sector < SECTOR_COUNT; ++sector) {
+            if (breadth.sectors[sector].change_percent > breadth.sectors[best].change_percent) best = sector;
+            if (breadth.sectors[sector].change_percent < breadth.sectors[worst].change_percent) worst = sector;
+        }
+        
+        std::ostringstream text;
+        text << "NIFTY " << (breadth.index_value > 0 ? MarketDataUtils::formatPrice(breadth.index_value) : "-")
+             << " (" << MarketDataUtils::formatPercent(breadth.index_change_percent) << ")"
+             << "  A/D " << breadth.advances << "/" << breadth.declines
+             << "  >VWAP " << static_cast<int>(breadth.percentAboveVwap()) << "%"
+             << "  >SMA50 " << static_cast<int>(breadth.percentAboveSma50()) << "%"
+             << "  " << MarketDataUtils::sectorToString(static_cast<Sector>(best)) << " "
+             << MarketDataUtils::formatPercent(breadth.sectors[best].change_percent)
+             << ", " << MarketDataUtils::sectorToString(static_cast<Sector>(worst)) << " "
+             << MarketDataUtils::formatPercent(breadth.sectors[worst].change_percent);
+        breadth_label_->setText(text.str());
+        breadth_label_->getRenderer()->setTextColor(breadth.index_change_percent >= 0 ? tgui::Color(0, 255, 136)
+                                                                                      : tgui::Color(255, 68, 68));
+    }
+}
+
+void GuiApp::updateMemoryStatus() {
+    if (history_manager_) {
+        if (memory_budget_.isNearLimit()) {
+            history_manager_->trimOldestRecords(memory_budget_.bytesOverTarget());
+        }
+        memory_budget_.report(MemorySubsystem::HISTORY, history_manager_->memoryBytes());
+    }
+    
+    size_t gui_bytes = 0;
+    if (displayed_view_) {
+        // The displayed view itself; widget rows are estimated below
+        if (displayed_view_->snapshot) gui_bytes += displayed_view_->snapshot->memoryBytes();
+        gui_bytes += displayed_view_->scan.memoryBytes();
+        gui_bytes += displayed_view_->setups.capacity() * sizeof(TradingSetup);
+        for (const auto& setup : displayed_view_->setups) {
+            gui_bytes += setup.supporting_signals.capacity() * sizeof(TradingSignal);
+        }
+    }
+    if (stocks_table_) gui_bytes += stocks_table_->getItemCount() * GUI_ROW_BYTES_ESTIMATE;
+    if (setups_list_) gui_bytes += setups_list_->getItemCount() * GUI_ROW_BYTES_ESTIMATE;
+    memory_budget_.report(MemorySubsystem::GUI, gui_bytes);
+    
+    if (memory_label_) {
+        std::string text = MemoryUtils::formatBreakdown(memory_budget_.breakdown());
+        if (displayed_view_ && displayed_view_->snapshot) {
+            const MarketSnapshot& snapshot = *displayed_view_->snapshot;
+            text += "  Cache " + std::to_string(static_cast<int>(snapshot.daily_cache_hit_rate * 100)) + "%/" +
+                    std::to_string(static_cast<int>(snapshot.intraday_cache_hit_rate * 100)) + "%";
+        }
+        memory_label_->setText(text);
+        bool near_limit = memory_budget_.isNearLimit();
+        memory_label_->getRenderer()->setTextColor(near_limit ? tgui::Color::Red : tgui::Color(160, 160, 160));
+    }
 }
 
 void GuiApp::updateMarketStatus() {
@@ -1,4 +1,5 @@
 #include "history_manager.h"
+#include <algorithm>
 #include <fstream>
 #include <filesystem>
 #include <sstream>
@@ -107,7 +108,7 @@ DailyTradingSummary HistoryManager::getDailySummary(const std::string& date) {
         summary.strategy_signal_count[signal.strategy]++;
         
         // Count by symbol
-        summary.symbol_activity[signal.symbol]++;
+        summary.symbol_activity[SymbolTable::symbol(signal.symbol)]++;
     }
     
     return summary;
@@ -127,9 +128,14 @@ bool HistoryManager::loadHistoryFromFile() {
     
     while (std::getline(file, line)) {
         // Parse CSV line into TradingSignal
-        // This is a simplified implementation
+        // This is a simplified implementation (symbol only)
+        std::istringstream fields(line);
+        std::string timestamp, symbol;
+        std::getline(fields, timestamp, ',');
+        std::getline(fields, symbol, ',');
+        
         TradingSignal signal;
-        signal.symbol = "SAMPLE"; // Would parse from CSV
+        signal.symbol = SymbolTable::intern(symbol);
         signal_history_.push_back(signal);
     }
     
@@ -146,19 +152,20 @@ bool HistoryManager::saveHistoryToFile() {
         }
         
         // Write header
-        file << "timestamp,symbol,type,strategy,entry_price,stop_loss,target_1,confidence\n";
+        file << "timestamp,symbol,type,strategy,entry_price,stop_loss,target_1,confidence,description\n";
         
         // Write signals
         for (const auto& signal : signal_history_) {
             auto time_t = std::chrono::system_clock::to_time_t(signal.timestamp);
             file << time_t << ","
-                 << signal.symbol << ","
+                 << SymbolTable::symbol(signal.symbol) << ","
                  << static_cast<int>(signal.type) << ","
                  << static_cast<int>(signal.strategy) << ","
                  << signal.entry_price << ","
                  << signal.stop_loss << ","
                  << signal.target_1 << ","
-                 << signal.confidence << "\n";
+                 << signal.confidence << ","
+                 << "\"" << SignalUtils::describeSignal(signal) << "\"\n";
         }
         
         return true;
@@ -191,6 +198,15 @@ size_t HistoryManager::getRecordCount() const {
     return signal_history_.size();
 }
 
+size_t HistoryManager::memoryBytes() const {
+    size_t total = signal_history_.capacity() * sizeof(TradingSignal) +
+                   setup_history_.capacity() * sizeof(TradingSetup);
+    for (const auto& setup : setup_history_) {
+        total += setup.supporting_signals.capacity() * sizeof(TradingSignal) + setup.symbol.capacity();
+    }
+    return total;
+}
+
 void HistoryManager::updateSignalResult(const std::string& signal_id, bool profitable, double return_pct) {
     // Find signal by ID and update result
     // This would be implemented in a full version
@@ -201,8 +217,11 @@ void HistoryManager::updateSignalResult(const std::string& signal_id, bool profi
 
 std::vector<TradingSignal> HistoryManager::getSignalsBySymbol(const std::string& symbol) {
     std::vector<TradingSignal> result;
+    SymbolId id = SymbolTable::find(symbol);
+    if (id == INVALID_SYMBOL_ID) return result;
+    
     for (const auto& signal : signal_history_) {
-        if (signal.symbol == symbol) {
+        if (signal.symbol == id) {
             result.push_back(signal);
         }
     }
@@ -254,3 +273,35 @@ void HistoryManager::cleanupOldRecords(int days_to_keep) {
                       }),
         signal_history_.end());
 }
+
+size_t HistoryManager::trimOldestRecords(size_t bytes_to_free) {
+    // Both lists are in recording order, oldest first
+    auto cutoff_time = std::chrono::system_clock::now() - std::chrono::hours(24);
+    size_t before = memoryBytes();
+    size_t estimate = 0;
+    
+    size_t signals = 0;
+    while (estimate < bytes_to_free && signals < signal_history_.size() &&
+           signal_history_[signals].timestamp < cutoff_time) {
+        estimate += sizeof(TradingSignal);
+        ++signals;
+    }
+    size_t setups = 0;
+    while (estimate < bytes_to_free && setups < setup_history_.size() &&
+           setup_history_[setups].created_at < cutoff_time) {
+        const auto& setup = setup_history_[setups];
+        estimate += sizeof(TradingSetup) + setup.supporting_signals.capacity() * sizeof(TradingSignal) +
+                    setup.symbol.capacity();
+        ++setups;
+    }
+    if (signals == 0 && setups == 0) return 0;
+    
+    signal_history_.erase(signal_history_.begin(), signal_history_.begin() + signals);
+    signal_history_.shrink_to_fit();
+    setup_history_.erase(setup_history_.begin(), setup_history_.begin() + setups);
+    setup_history_.shrink_to_fit();
+    invalidateCache();
+    
+    size_t after = memoryBytes();
+    return before > after ? before - after : 0;
+}
@@ -0,0 +1,256 @@
+#include "indicator_batch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define HFT_BATCH_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    // Periods match IndicatorState
+    constexpr int EMA_FAST_PERIODS = 9;
+    constexpr int EMA_SLOW_PERIODS = 21;
+    constexpr int WILDER_PERIODS = 14;   // RSI and ATR
+
+    constexpr double EMA_FAST_ALPHA = 2.0 / (EMA_FAST_PERIODS + 1);
+    constexpr double EMA_SLOW_ALPHA = 2.0 / (EMA_SLOW_PERIODS + 1);
+}
+
+// BarColumn
+void BarColumn::resize(size_t symbols) {
+    high.assign(symbols, 0);
+    low.assign(symbols, 0);
+    close.assign(symbols, 0);
+}
+
+void BarColumn::set(size_t index, const OHLCV& bar) {
+    high[index] = bar.high.paise;
+    low[index] = bar.low.paise;
+    close[index] = bar.close.paise;
+}
+
+// IndicatorBatch
+IndicatorBatch::IndicatorBatch(size_t symbols, int bollinger_periods, double bollinger_multiplier)
+    : symbols_(symbols), bollinger_periods_(bollinger_periods),
+      bollinger_multiplier_(bollinger_multiplier), kernel_(bestKernel()),
+      ema_9_(symbols, 0.0), ema_21_(symbols, 0.0), avg_gain_(symbols, 0.0), avg_loss_(symbols, 0.0),
+      atr_(symbols, 0.0), prev_close_(symbols, 0),
+      window_(static_cast<size_t>(bollinger_periods) * symbols, 0), window_head_(0),
+      sum_(symbols, 0), sum_sq_(symbols, 0), seeded_(symbols, 0) {
+}
+
+bool IndicatorBatch::seed(size_t index, const IndicatorState& state) {
+    if (index >= symbols_) return false;
+    if (!state.ema_21.ready() || !state.rsi_14.ready() || !state.atr_14.ready() ||
+        !state.bollinger_20.ready() || state.bollinger_20.periods() != bollinger_periods_) {
+        return false;
+    }
+
+    ema_9_[index] = state.ema_9.value();
+    ema_21_[index] = state.ema_21.value();
+    avg_gain_[index] = state.rsi_14.averageGain();
+    avg_loss_[index] = state.rsi_14.averageLoss();
+    atr_[index] = state.atr_14.value();
+    prev_close_[index] = state.rsi_14.previousClose().paise;
+
+    // Lay the window out so its oldest close sits in the row evicted next
+    auto closes = state.bollinger_20.window();
+    std::int64_t sum = 0, sum_sq = 0;
+    for (size_t k = 0; k < closes.size(); ++k) {
+        size_t row = (window_head_ + k) % bollinger_periods_;
+        window_[row * symbols_ + index] = closes[k];
+        sum += closes[k];
+        sum_sq += static_cast<std::int64_t>(closes[k]) * closes[k];
+    }
+    sum_[index] = sum;
+    sum_sq_[index] = sum_sq;
+
+    seeded_[index] = 1;
+    return true;
+}
+
+void IndicatorBatch::update(const BarColumn& bars) {
+    if (bars.size() != symbols_ || symbols_ == 0) return;
+
+    if (kernel_ == BatchKernel::AVX2) {
+        updateAVX2(bars);
+    } else {
+        updateScalar(bars, 0, symbols_);
+    }
+
+    window_head_ = (window_head_ + 1) % bollinger_periods_;
+}
+
+// Same operations, in the same order, as the Streaming* classes
+void IndicatorBatch::updateScalar(const BarColumn& bars, size_t begin, size_t end) {
+    std::int32_t* oldest_row = window_.data() + window_head_ * symbols_;
+
+    for (size_t i = begin; i < end; ++i) {
+        std::int32_t close = bars.close[i];
+        std::int32_t prev = prev_close_[i];
+        double close_rupees = close / 100.0;
+
+        ema_9_[i] = close_rupees * EMA_FAST_ALPHA + ema_9_[i] * (1 - EMA_FAST_ALPHA);
+        ema_21_[i] = close_rupees * EMA_SLOW_ALPHA + ema_21_[i] * (1 - EMA_SLOW_ALPHA);
+
+        double change = (close - prev) / 100.0;
+        double gain = change > 0 ? change : 0;
+        double loss = change < 0 ? -change : 0;
+        avg_gain_[i] = ((avg_gain_[i] * (WILDER_PERIODS - 1)) + gain) / WILDER_PERIODS;
+        avg_loss_[i] = ((avg_loss_[i] * (WILDER_PERIODS - 1)) + loss) / WILDER_PERIODS;
+
+        std::int32_t hl = bars.high[i] - bars.low[i];
+        std::int32_t hc = std::abs(bars.high[i] - prev);
+        std::int32_t lc = std::abs(bars.low[i] - prev);
+        double true_range = std::max({hl, hc, lc}) / 100.0;
+        atr_[i] = ((atr_[i] * (WILDER_PERIODS - 1)) + true_range) / WILDER_PERIODS;
+
+        std::int64_t oldest = oldest_row[i];
+        oldest_row[i] = close;
+        sum_[i] += close - oldest;
+        sum_sq_[i] += static_cast<std::int64_t>(close) * close - oldest * oldest;
+
+        prev_close_[i] = close;
+    }
+}
+
+#ifdef HFT_BATCH_AVX2
+__attribute__((target("avx2")))
+void IndicatorBatch::updateAVX2(const BarColumn& bars) {
+    const size_t vector_end = symbols_ - symbols_ % 4;
+    std::int32_t* oldest_row = window_.data() + window_head_ * symbols_;
+
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d fast_alpha = _mm256_set1_pd(EMA_FAST_ALPHA);
+    const __m256d fast_keep = _mm256_set1_pd(1 - EMA_FAST_ALPHA);
+    const __m256d slow_alpha = _mm256_set1_pd(EMA_SLOW_ALPHA);
+    const __m256d slow_keep = _mm256_set1_pd(1 - EMA_SLOW_ALPHA);
+    const __m256d wilder_keep = _mm256_set1_pd(WILDER_PERIODS - 1);
+    const __m256d wilder_periods = _mm256_set1_pd(WILDER_PERIODS);
+
+    for (size_t i = 0; i < vector_end; i += 4) {
+        __m128i close = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bars.close.data() + i));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bars.high.data() + i));
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bars.low.data() + i));
+        __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev_close_.data() + i));
+        __m256d close_rupees = _mm256_div_pd(_mm256_cvtepi32_pd(close), hundred);
+
+        // EMA: close * alpha + ema * (1 - alpha)
+        __m256d ema = _mm256_loadu_pd(ema_9_.data() + i);
+        ema = _mm256_add_pd(_mm256_mul_pd(close_rupees, fast_alpha), _mm256_mul_pd(ema, fast_keep));
+        _mm256_storeu_pd(ema_9_.data() + i, ema);
+
+        ema = _mm256_loadu_pd(ema_21_.data() + i);
+        ema = _mm256_add_pd(_mm256_mul_pd(close_rupees, slow_alpha), _mm256_mul_pd(ema, slow_keep));
+        _mm256_storeu_pd(ema_21_.data() + i, ema);
+
+        // RSI: Wilder-smoothed average gain and loss
+        __m256d change = _mm256_div_pd(_mm256_cvtepi32_pd(_mm_sub_epi32(close, prev)), hundred);
+        __m256d gain = _mm256_max_pd(change, zero);
+        __m256d loss = _mm256_max_pd(_mm256_sub_pd(zero, change), zero);
+
+        __m256d avg = _mm256_loadu_pd(avg_gain_.data() + i);
+        avg = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(avg, wilder_keep), gain), wilder_periods);
+        _mm256_storeu_pd(avg_gain_.data() + i, avg);
+
+        avg = _mm256_loadu_pd(avg_loss_.data() + i);
+        avg = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(avg, wilder_keep), loss), wilder_periods);
+        _mm256_storeu_pd(avg_loss_.data() + i, avg);
+
+        // ATR: true range in integer paise, then Wilder smoothing
+        __m128i hl = _mm_sub_epi32(high, low);
+        __m128i hc = _mm_abs_epi32(_mm_sub_epi32(high, prev));
+        __m128i lc = _mm_abs_epi32(_mm_sub_epi32(low, prev));
+        __m128i range_paise = _mm_max_epi32(_mm_max_epi32(hl, hc), lc);
+        __m256d true_range = _mm256_div_pd(_mm256_cvtepi32_pd(range_paise), hundred);
+
+        __m256d atr = _mm256_loadu_pd(atr_.data() + i);
+        atr = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(atr, wilder_keep), true_range), wilder_periods);
+        _mm256_storeu_pd(atr_.data() + i, atr);
+
+        // Bollinger: swap the oldest close for the new one in the exact sums
+        __m128i oldest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(oldest_row + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(oldest_row + i), close);
+
+        __m256i close_64 = _mm256_cvtepi32_epi64(close);
+        __m256i oldest_64 = _mm256_cvtepi32_epi64(oldest);
+
+        __m256i sum = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sum_.data() + i));
+        sum = _mm256_add_epi64(sum, _mm256_sub_epi64(close_64, oldest_64));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sum_.data() + i), sum);
+
+        // _mm256_mul_epi32 squares the signed low 32 bits of each lane into 64
+        __m256i sum_sq = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sum_sq_.data() + i));
+        sum_sq = _mm256_add_epi64(sum_sq, _mm256_sub_epi64(_mm256_mul_epi32(close_64, close_64),
+                                                           _mm256_mul_epi32(oldest_64, oldest_64)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sum_sq_.data() + i), sum_sq);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(prev_close_.data() + i), close);
+    }
+
+    updateScalar(bars, vector_end, symbols_);
+}
+#else
+void IndicatorBatch::updateAVX2(const BarColumn& bars) {
+    updateScalar(bars, 0, symbols_);
+}
+#endif
+
+void IndicatorBatch::apply(size_t index, StockData& stock) const {
+    if (index >= symbols_ || !seeded_[index]) return;
+
+    stock.rsi_14 = rsi(index);
+    stock.ema_9 = ema_9_[index];
+    stock.ema_21 = ema_21_[index];
+    stock.atr_14 = atr_[index];
+
+    auto bb = bollinger(index);
+    stock.sma_20 = bb.middle;
+    stock.bollinger_upper = bb.upper;
+    stock.bollinger_lower = bb.lower;
+}
+
+double IndicatorBatch::rsi(size_t index) const {
+    if (avg_loss_[index] == 0) return 100.0;
+
+    double rs = avg_gain_[index] / avg_loss_[index];
+    return 100.0 - (100.0 / (1.0 + rs));
+}
+
+BollingerBands IndicatorBatch::bollinger(size_t index) const {
+    double mean = static_cast<double>(sum_[index]) / bollinger_periods_;
+    double variance = static_cast<double>(sum_sq_[index]) / bollinger_periods_ - mean * mean;
+    double std_dev = std::sqrt(std::max(0.0, variance)) / 100.0;
+    double middle = mean / 100.0;
+
+    return BollingerBands(
+        middle + (bollinger_multiplier_ * std_dev),
+        middle,
+        middle - (bollinger_multiplier_ * std_dev)
+    );
+}
+
+void IndicatorBatch::setKernel(BatchKernel kernel) {
+    kernel_ = (kernel == BatchKernel::AVX2 && bestKernel() != BatchKernel::AVX2)
+                  ? BatchKernel::SCALAR : kernel;
+}
+
+BatchKernel IndicatorBatch::bestKernel() {
+#ifdef HFT_BATCH_AVX2
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2 ? BatchKernel::AVX2 : BatchKernel::SCALAR;
+#else
+    return BatchKernel::SCALAR;
+#endif
+}
+
+const char* IndicatorBatch::kernelName(BatchKernel kernel) {
+    switch (kernel) {
+        case BatchKernel::SCALAR: return "scalar";
+        case BatchKernel::AVX2: return "avx2";
+        default: return "unknown";
+    }
+}
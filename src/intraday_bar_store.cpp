@@ -0,0 +1,211 @@
+#include "intraday_bar_store.h"
+#include <algorithm>
+
+BarAggregator::BarAggregator(BarInterval interval) : period_(barPeriod(interval)) {
+    reset();
+}
+
+bool BarAggregator::update(const OHLCV& bar) {
+    if (has_newest_ && bar.timestamp < newest_.timestamp) return false;
+
+    if (!has_newest_ || bucketStart(bar.timestamp) != current_.timestamp) {
+        // First bar of a new bucket
+        has_folded_ = false;
+    } else if (bar.timestamp > newest_.timestamp) {
+        // The previous newest bar is final now
+        if (has_folded_) {
+            merge(folded_, newest_);
+        } else {
+            folded_ = newest_;
+            has_folded_ = true;
+        }
+    }
+    newest_ = bar;
+    has_newest_ = true;
+
+    current_ = newest_;
+    if (has_folded_) {
+        current_.open = folded_.open;
+        merge(current_, folded_);
+    }
+    current_.timestamp = bucketStart(bar.timestamp);
+    return true;
+}
+
+void BarAggregator::reset() {
+    folded_ = OHLCV();
+    newest_ = OHLCV();
+    current_ = OHLCV();
+    has_folded_ = false;
+    has_newest_ = false;
+}
+
+std::chrono::system_clock::time_point BarAggregator::bucketStart(std::chrono::system_clock::time_point time) const {
+    auto since_epoch = std::chrono::duration_cast<std::chrono::minutes>(time.time_since_epoch());
+    return std::chrono::system_clock::time_point(since_epoch - since_epoch % period_);
+}
+
+void BarAggregator::merge(OHLCV& into, const OHLCV& bar) {
+    into.high = std::max(into.high, bar.high);
+    into.low = std::min(into.low, bar.low);
+    into.volume += bar.volume;
+}
+
+IntradayBarStore::SeriesSet::SeriesSet()
+    : rollups{{BarAggregator(BarInterval::FIVE_MINUTES), BarAggregator(BarInterval::FIFTEEN_MINUTES),
+               BarAggregator(BarInterval::DAILY)}},
+      last_ingest(0), trimmed(false) {}
+
+IntradayBarStore::IntradayBarStore(const BarStoreConfig& config) : config_(config), ingest_clock_(0) {
+}
+
+void IntradayBarStore::configure(const BarStoreConfig& config) {
+    config_ = config;
+    for (auto& set : series_) {
+        allocate(set);
+    }
+}
+
+void IntradayBarStore::reserveSymbols(size_t symbol_count) {
+    if (symbol_count <= series_.size()) return;
+
+    size_t first_new = series_.size();
+    series_.resize(symbol_count);
+    for (size_t i = first_new; i < series_.size(); ++i) {
+        allocate(series_[i]);
+    }
+}
+
+void IntradayBarStore::ingest(SymbolId symbol, BarInterval interval, const OHLCV& bar) {
+    auto& set = seriesFor(symbol);
+    set.last_ingest = ++ingest_clock_;
+    auto& buffer = set.buffers[static_cast<size_t>(interval)];
+
+    if (buffer.empty() || bar.timestamp > buffer.back().timestamp) {
+        buffer.push(bar);
+    } else if (bar.timestamp == buffer.back().timestamp) {
+        buffer.replaceLast(bar);
+    }
+    // Older bars are already stored (or have been rolled out)
+}
+
+void IntradayBarStore::ingest(SymbolId symbol, BarInterval interval, CandleSpan bars) {
+    for (const auto& bar : bars) {
+        ingest(symbol, interval, bar);
+    }
+}
+
+void IntradayBarStore::ingestBase(SymbolId symbol, const OHLCV& bar) {
+    ingest(symbol, BarInterval::ONE_MINUTE, bar);
+
+    // Each timeframe is fed the current bar of the one below it
+    auto& rollups = seriesFor(symbol).rollups;
+    const OHLCV* lower = &bar;
+    for (size_t i = 0; i < rollups.size(); ++i) {
+        if (!rollups[i].update(*lower)) return;
+        ingest(symbol, static_cast<BarInterval>(i + 1), rollups[i].current());
+        lower = &rollups[i].current();
+    }
+}
+
+CandleSpan IntradayBarStore::bars(SymbolId symbol, BarInterval interval) const {
+    if (symbol >= series_.size()) return CandleSpan();
+    return series_[symbol].buffers[static_cast<size_t>(interval)].view();
+}
+
+CandleSpan IntradayBarStore::recent(SymbolId symbol, BarInterval interval, size_t count) const {
+    if (symbol >= series_.size()) return CandleSpan();
+    return series_[symbol].buffers[static_cast<size_t>(interval)].window(count);
+}
+
+size_t IntradayBarStore::barCount(SymbolId symbol, BarInterval interval) const {
+    if (symbol >= series_.size()) return 0;
+    return series_[symbol].buffers[static_cast<size_t>(interval)].size();
+}
+
+size_t IntradayBarStore::memoryBytes() const {
+    size_t total = series_.capacity() * sizeof(SeriesSet);
+    for (const auto& set : series_) {
+        total += setBytes(set);
+    }
+    return total;
+}
+
+size_t IntradayBarStore::trimColdHistory(size_t bytes_to_free) {
+    size_t freed = 0;
+    for (SymbolId id : byLastIngest()) {
+        if (freed >= bytes_to_free) break;
+        
+        // Keeps the newest bars, so the current session and the rollups' bars survive
+        auto& set = series_[id];
+        size_t before = setBytes(set);
+        for (size_t i = 0; i < BAR_INTERVAL_COUNT; ++i) {
+            size_t capacity = std::min(config_.capacity[i], trimmedBars(static_cast<BarInterval>(i)));
+            if (capacity < set.buffers[i].capacity()) {
+                set.buffers[i].resize(capacity);
+                set.trimmed = true;
+            }
+        }
+        freed += before - setBytes(set);
+    }
+    return freed;
+}
+
+size_t IntradayBarStore::restoreCapacity(size_t bytes_available) {
+    auto order = byLastIngest();
+    size_t added = 0;
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        auto& set = series_[*it];
+        if (!set.trimmed) continue;
+        
+        size_t growth = 0;
+        for (size_t i = 0; i < BAR_INTERVAL_COUNT; ++i) {
+            growth += (config_.capacity[i] - set.buffers[i].capacity()) * 2 * sizeof(OHLCV);
+        }
+        if (added + growth > bytes_available) break;
+        
+        size_t before = setBytes(set);
+        for (size_t i = 0; i < BAR_INTERVAL_COUNT; ++i) {
+            set.buffers[i].resize(config_.capacity[i]);
+        }
+        set.trimmed = false;
+        added += setBytes(set) - before;
+    }
+    return added;
+}
+
+std::vector<SymbolId> IntradayBarStore::byLastIngest() const {
+    std::vector<SymbolId> order;
+    order.reserve(series_.size());
+    for (size_t id = 0; id < series_.size(); ++id) {
+        order.push_back(static_cast<SymbolId>(id));
+    }
+    std::sort(order.begin(), order.end(), [this](SymbolId a, SymbolId b) {
+        return series_[a].last_ingest < series_[b].last_ingest;
+    });
+    return order;
+}
+
+IntradayBarStore::SeriesSet& IntradayBarStore::seriesFor(SymbolId symbol) {
+    if (symbol >= series_.size()) {
+        reserveSymbols(static_cast<size_t>(symbol) + 1);
+    }
+    return series_[symbol];
+}
+
+void IntradayBarStore::allocate(SeriesSet& set) const {
+    for (size_t i = 0; i < BAR_INTERVAL_COUNT; ++i) {
+        if (set.buffers[i].capacity() != config_.capacity[i]) {
+            set.buffers[i].reset(config_.capacity[i]);
+        }
+    }
+    set.trimmed = false;
+}
+
+size_t IntradayBarStore::setBytes(const SeriesSet& set) {
+    size_t total = 0;
+    for (const auto& buffer : set.buffers) {
+        total += buffer.memoryBytes();
+    }
+    return total;
+}
@@ -1,7 +1,16 @@
 #include "gui_app.h"
 #include "yahoo_finance_api.h"
 #include "strategy_engine.h"
+#include "allocation_stats.h"
+#include "memory_budget.h"
+#include "indicator_batch.h"
+#include "correlation_matrix.h"
+#include "anomaly_detector.h"
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
 #include <exception>
 #include <csignal>
 #include <cstring>
@@ -18,6 +27,261 @@ void signalHandler(int signal) {
     exit(signal);
 }
 
+// Run a few analysis cycles over synthetic quotes and report per-cycle
+// heap usage; steady-state cycles should be served from the arena alone
+void reportAnalysisCycleAllocations(StrategyEngine& engine) {
+    const char* symbols[] = {"RELIANCE.NS", "TCS.NS", "HDFCBANK.NS", "INFY.NS", "ICICIBANK.NS",
+                             "SBIN.NS", "ITC.NS", "LT.NS", "AXISBANK.NS", "MARUTI.NS"};
+    
+    std::vector<StockData> stocks;
+    std::map<std::string, HistoricalData> historical;
+    for (size_t i = 0; i < sizeof(symbols) / sizeof(symbols[0]); ++i) {
+        StockData stock;
+        stock.symbol_id = SymbolTable::intern(symbols[i]);
+        stock.current_price = Price::fromPaise(150000 + static_cast<int>(i) * 2500);
+        stock.change = Price::fromPaise(i % 2 ? -1500 : 1500);
+        stock.volume = 2000000;
+        stock.avg_volume = 1000000;
+        stock.volume_ratio = 2.0;
+        stock.volume_spike = true;
+        stock.is_breakout = (i % 3 == 0);
+        stock.rsi_14 = (i % 2) ? 75.0 : 25.0;
+        stock.vwap = stock.current_price.toDouble() * ((i % 2) ? 1.015 : 0.985);
+        stocks.push_back(stock);
+        
+        HistoricalData& hist = historical[symbols[i]];
+        hist.symbol = symbols[i];
+        for (int c = 0; c < 30; ++c) {
+            Price base = Price::fromPaise(145000 + static_cast<int>(i) * 2500 + c * 100);
+            hist.candles.emplace_back(base, base + Price::fromPaise(2000), base - Price::fromPaise(2000),
+                                      base + Price::fromPaise(200), 100000);
+        }
+    }
+    
+    if (!AllocationStats::isTracking()) {
+        std::cout << "  ⚠️  Heap tracking disabled (make profile, or cmake -DHFT_TRACK_ALLOCATIONS=ON)" << std::endl;
+    }
+    
+    for (int cycle = 1; cycle <= 5; ++cycle) {
+        engine.generateSetups(stocks, historical);
+        const auto& stats = engine.getLastCycleStats();
+        std::cout << "  📊 Cycle " << cycle << ": " << stats.stocks_analyzed << " stocks, "
+                  << stats.signals_generated << " signals, " << stats.setups_generated << " setups, "
+                  << stats.arena_bytes << " arena bytes, " << stats.heap_allocations
+                  << " heap allocations (" << stats.heap_bytes << " bytes)" << std::endl;
+    }
+}
+
+// Time one bar-close update of the batch indicators across a synthetic
+// universe, with each available kernel; false if the kernels disagree
+bool reportBatchIndicatorUpdate(size_t symbols = 5000) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> step(-400, 400);
+    std::uniform_int_distribution<int> wick(0, 300);
+    
+    auto makeBar = [&](std::int32_t& price) {
+        std::int32_t open = price;
+        price = std::max(100, price + step(rng));
+        Price high = Price::fromPaise(std::max(open, price) + wick(rng));
+        Price low = Price::fromPaise(std::min(open, price) - wick(rng));
+        return OHLCV(Price::fromPaise(open), high, low, Price::fromPaise(price), 100000);
+    };
+    
+    // Warm every symbol through the streaming path, then seed the batch
+    IndicatorBatch batch(symbols);
+    std::vector<std::int32_t> prices(symbols);
+    for (size_t i = 0; i < symbols; ++i) {
+        prices[i] = 50000 + static_cast<std::int32_t>(i % 400) * 1000;
+        IndicatorState state;
+        auto start = std::chrono::system_clock::now();
+        for (int b = 0; b < 60; ++b) {
+            OHLCV bar = makeBar(prices[i]);
+            bar.timestamp = start + std::chrono::hours(24 * b);
+            state.update(bar);
+        }
+        batch.seed(i, state);
+    }
+    
+    const int closes = 200;
+    std::vector<BarColumn> columns(closes, BarColumn(symbols));
+    for (auto& column : columns) {
+        for (size_t i = 0; i < symbols; ++i) {
+            column.set(i, makeBar(prices[i]));
+        }
+    }
+    
+    std::vector<BatchKernel> kernels = {BatchKernel::SCALAR};
+    if (IndicatorBatch::bestKernel() == BatchKernel::AVX2) kernels.push_back(BatchKernel::AVX2);
+    
+    std::vector<IndicatorBatch> results;
+    for (BatchKernel kernel : kernels) {
+        IndicatorBatch run = batch;
+        run.setKernel(kernel);
+        
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& column : columns) {
+            run.update(column);
+        }
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+        
+        std::cout << "  🧮 Batch bar close (" << IndicatorBatch::kernelName(kernel) << "): "
+                  << symbols << " symbols in " << elapsed.count() / closes << " µs" << std::endl;
+        results.push_back(std::move(run));
+    }
+    
+    if (results.size() > 1) {
+        double max_diff = 0.0;
+        for (size_t i = 0; i < symbols; ++i) {
+            max_diff = std::max({max_diff,
+                                 std::abs(results[0].ema21(i) - results[1].ema21(i)),
+                                 std::abs(results[0].rsi(i) - results[1].rsi(i)),
+                                 std::abs(results[0].atr(i) - results[1].atr(i)),
+                                 std::abs(results[0].bollinger(i).upper - results[1].bollinger(i).upper)});
+        }
+        std::cout << "  " << (max_diff == 0.0 ? "✅ Kernels agree" : "❌ Kernels disagree") << " (max difference "
+                  << max_diff << ")" << std::endl;
+        return max_diff == 0.0;
+    }
+    return true;
+}
+
+// Time one bar-close update of the rolling correlation matrix across a
+// synthetic universe, with each available kernel; false if they disagree
+bool reportCorrelationUpdate(size_t symbols = 500) {
+    std::mt19937 rng(7);
+    std::normal_distribution<double> shock(0.0, 1.0);
+    
+    // A market factor plus noise, so the matrix has structure to find
+    const int closes = 200;
+    std::vector<std::vector<std::int32_t>> columns(closes, std::vector<std::int32_t>(symbols));
+    std::vector<double> prices(symbols, 1000.0);
+    for (auto& column : columns) {
+        double market = shock(rng);
+        for (size_t i = 0; i < symbols; ++i) {
+            double beta = static_cast<double>(i % 4) / 3.0;
+            prices[i] *= 1.0 + 0.002 * (beta * market + shock(rng));
+            column[i] = static_cast<std::int32_t>(std::lround(prices[i] * 100.0));
+        }
+    }
+    
+    std::vector<BatchKernel> kernels = {BatchKernel::SCALAR};
+    if (IndicatorBatch::bestKernel() == BatchKernel::AVX2) kernels.push_back(BatchKernel::AVX2);
+    
+    std::vector<CorrelationMatrix> results;
+    for (BatchKernel kernel : kernels) {
+        CorrelationMatrix matrix(symbols, 60);
+        matrix.setKernel(kernel);
+        
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& column : columns) {
+            matrix.update(column);
+        }
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        
+        std::cout << "  🔗 Correlation bar close (" << IndicatorBatch::kernelName(kernel) << "): "
+                  << symbols << " symbols in " << elapsed.count() / closes << " ms" << std::endl;
+        results.push_back(std::move(matrix));
+    }
+    
+    if (results.size() > 1) {
+        double max_diff = 0.0;
+        for (SymbolId i = 0; i < symbols; i += 7) {
+            for (SymbolId j = 0; j < symbols; j += 5) {
+                max_diff = std::max(max_diff, std::abs(results[0].correlation(i, j) - results[1].correlation(i, j)));
+            }
+        }
+        std::cout << "  " << (max_diff == 0.0 ? "✅ Kernels agree" : "❌ Kernels disagree") << " (max difference "
+                  << max_diff << ")" << std::endl;
+        return max_diff == 0.0;
+    }
+    return true;
+}
+
+// Replay a synthetic session through AnomalyMonitor the way each quote
+// fetch does (every bar so far, oldest first) and check what the newest
+// bar reports: an old shock is not raised again, a shock is fresh once,
+// and a clean bar after a bad print lifts the quarantine
+bool checkAnomalyReplay() {
+    std::mt19937 rng(11);
+    std::normal_distribution<double> step(0.0, 0.5);
+    std::uniform_int_distribution<int> volume(900, 1100);
+    
+    std::vector<OHLCV> session;
+    double price = 1000.0;
+    auto open = std::chrono::system_clock::now() - std::chrono::hours(6);
+    auto addBar = [&](double close, Quantity bar_volume) {
+        OHLCV bar(Price::fromRupees(price), Price::fromRupees(std::max(price, close) + 0.2),
+                  Price::fromRupees(std::min(price, close) - 0.2), Price::fromRupees(close), bar_volume);
+        bar.timestamp = open + std::chrono::minutes(session.size());
+        session.push_back(bar);
+    };
+    for (int i = 0; i < 60; ++i) {
+        double close = price + step(rng);
+        addBar(close, i == 45 ? 50000 : volume(rng));   // an early volume shock
+        price = close;
+    }
+    
+    AnomalyMonitor monitor;
+    const SymbolId symbol = 0;
+    bool early_shock_seen = false;
+    auto fetch = [&]() {
+        AnomalyCheck newest;
+        for (const auto& bar : session) {
+            newest = monitor.check(symbol, bar);
+            if (newest.type == AnomalyType::VOLUME_SHOCK) early_shock_seen = true;
+        }
+        return newest;
+    };
+    
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cout << "  ❌ Anomaly replay: " << what << std::endl;
+            ok = false;
+        }
+    };
+    
+    AnomalyCheck first = fetch();
+    expect(early_shock_seen, "early volume shock not detected");
+    expect(first.type == AnomalyType::NONE, "old shock reported on the newest bar");
+    expect(fetch().type == AnomalyType::NONE, "old shock reported on a repeated fetch");
+    
+    addBar(price + step(rng), 60000);
+    AnomalyCheck shock = fetch();
+    expect(shock.type == AnomalyType::VOLUME_SHOCK && shock.fresh, "new volume shock not fresh");
+    AnomalyCheck repeated = fetch();
+    expect(repeated.type == AnomalyType::VOLUME_SHOCK && !repeated.fresh, "cached shock escalated again");
+    
+    price = session.back().close.toDouble();
+    addBar(price * 1.3, volume(rng));   // bad print, no volume behind it
+    expect(fetch().type == AnomalyType::BAD_PRINT, "bad print not quarantined");
+    addBar(price + step(rng), volume(rng));
+    expect(fetch().type == AnomalyType::NONE, "clean bar did not lift the quarantine");
+    
+    if (ok) std::cout << "  ✅ Anomaly replay: shocks raised once, quarantine lifted by a clean bar" << std::endl;
+    return ok;
+}
+
+// Fetch a few index heavyweights and check breadth gets real SMA(50)s,
+// i.e. the daily history reaches back 50 sessions; skipped when offline
+bool checkMarketBreadth(YahooFinanceAPI& api) {
+    api.getQuotes({"RELIANCE.NS", "HDFCBANK.NS", "ICICIBANK.NS", "INFY.NS", "TCS.NS"});
+    auto breadth = api.getMarketBreadth().breadth();
+    if (breadth.constituents_priced == 0) {
+        std::cout << "  ⚠️  No quotes (offline?), breadth check skipped" << std::endl;
+        return true;
+    }
+    
+    std::cout << "  📐 Breadth over " << breadth.constituents_priced << " constituents: A/D "
+              << breadth.advances << "/" << breadth.declines << ", " << breadth.with_sma_50
+              << " with SMA(50), " << static_cast<int>(breadth.percentAboveSma50()) << "% above" << std::endl;
+    if (breadth.with_sma_50 == 0) {
+        std::cout << "  ❌ No constituent has an SMA(50); daily history is too short" << std::endl;
+        return false;
+    }
+    return true;
+}
+
 // Headless mode for testing core functionality
 int runHeadlessTest() {
     std::cout << "===========================================================" << std::endl;
@@ -31,10 +295,29 @@ int runHeadlessTest() {
         YahooFinanceAPI api;
         std::cout << "  ✅ API initialized successfully" << std::endl;
         
+        std::cout << "📐 Testing market breadth on live quotes..." << std::endl;
+        if (!checkMarketBreadth(api)) return -1;
+        
         // Test Strategy Engine  
         std::cout << "🎯 Testing Strategy Engine..." << std::endl;
         StrategyEngine engine;
         std::cout << "  ✅ Strategy engine initialized successfully" << std::endl;
+        reportAnalysisCycleAllocations(engine);
+        
+        std::cout << "🚨 Testing anomaly detection on a replayed session..." << std::endl;
+        if (!checkAnomalyReplay()) return -1;
+        
+        std::cout << "🧮 Testing batch indicator kernels..." << std::endl;
+        if (!reportBatchIndicatorUpdate() || !reportCorrelationUpdate()) return -1;
+        
+        MemoryBudget budget;
+        budget.report(MemorySubsystem::CANDLES, api.getIntradayBars().memoryBytes());
+        budget.report(MemorySubsystem::INDICATORS, engine.memoryBytes());
+        std::cout << "  🧠 " << MemoryUtils::formatBreakdown(budget.breakdown()) << std::endl;
+        const IndicatorEngine& indicators = api.getIndicators();
+        std::cout << "  🧮 Indicator cache hit rate: daily "
+                  << static_cast<int>(indicators.dailyCacheStats().hitRate() * 100) << "%, intraday "
+                  << static_cast<int>(indicators.intradayCacheStats().hitRate() * 100) << "%" << std::endl;
         
         std::cout << "\n🎉 All core components working!" << std::endl;
         std::cout << "📝 GUI requires display - run with display server for full functionality" << std::endl;
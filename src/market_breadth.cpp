@@ -0,0 +1,104 @@
+#include "market_breadth.h"
+
+MarketBreadthEngine::MarketBreadthEngine(Span<const IndexConstituent> constituents)
+    : constituents_priced_(0), reference_(0), has_reference_(false) {
+    counts_.fill(0);
+    for (auto& counts : sector_counts_) counts.fill(0);
+
+    for (const auto& constituent : constituents) {
+        SymbolState& state = stateFor(SymbolTable::intern(constituent.symbol));
+        state.sector = constituent.sector;
+        state.weight = constituent.weight;
+    }
+}
+
+MarketBreadthEngine::SymbolState& MarketBreadthEngine::stateFor(SymbolId symbol) {
+    if (symbol >= symbols_.size()) symbols_.resize(symbol + 1);
+    return symbols_[symbol];
+}
+
+void MarketBreadthEngine::apply(const SymbolState& state, int sign) {
+    if (!state.priced) return;
+
+    auto& sector_counts = sector_counts_[static_cast<size_t>(state.sector)];
+    for (int flag = 0; flag < FLAG_COUNT; ++flag) {
+        if (!(state.flags & (1u << flag))) continue;
+        counts_[flag] += sign;
+        if (flag <= UNCHANGED) sector_counts[flag] += sign;
+    }
+
+    if (state.units <= 0) return;
+    double weighted_price = state.units * state.price.toDouble();
+    Totals& sector = sector_totals_[static_cast<size_t>(state.sector)];
+    sector.weighted_price += sign * weighted_price;
+    sector.weight += sign * state.weight;
+    index_.weighted_price += sign * weighted_price;
+    index_.weight += sign * state.weight;
+    constituents_priced_ += sign;
+}
+
+void MarketBreadthEngine::update(const StockData& stock) {
+    if (stock.symbol_id == INVALID_SYMBOL_ID) return;
+    SymbolState& state = stateFor(stock.symbol_id);
+    apply(state, -1);
+
+    // A constituent rolling to a new previous close starts a new session
+    if (state.weight > 0 && state.previous_close.isPositive() && stock.previous_close != state.previous_close) {
+        has_reference_ = false;
+    }
+    state.previous_close = stock.previous_close;
+    state.units = stock.previous_close.isPositive() ? state.weight / stock.previous_close.toDouble() : 0.0;
+    state.price = stock.current_price;
+    state.priced = stock.current_price.isPositive();
+
+    double price = stock.current_price.toDouble();
+    int direction = stock.change.isPositive() ? ADVANCING : stock.change < Price() ? DECLINING : UNCHANGED;
+    unsigned flags = 1u << direction;
+    if (stock.vwap > 0) flags |= (1u << HAS_VWAP) | (price > stock.vwap ? 1u << ABOVE_VWAP : 0u);
+    // sma_50 is 0 until the daily history holds 50 sessions (YahooFinanceAPI::DAILY_HISTORY_RANGE)
+    if (stock.sma_50 > 0) flags |= (1u << HAS_SMA_50) | (price > stock.sma_50 ? 1u << ABOVE_SMA_50 : 0u);
+    state.flags = static_cast<std::uint8_t>(flags);
+
+    apply(state, 1);
+}
+
+void MarketBreadthEngine::setReference(double index_previous_close) {
+    reference_ = index_previous_close;
+    has_reference_ = index_previous_close > 0;
+}
+
+MarketBreadth MarketBreadthEngine::breadth() const {
+    MarketBreadth breadth;
+    breadth.advances = counts_[ADVANCING];
+    breadth.declines = counts_[DECLINING];
+    breadth.unchanged = counts_[UNCHANGED];
+    breadth.with_vwap = counts_[HAS_VWAP];
+    breadth.above_vwap = counts_[ABOVE_VWAP];
+    breadth.with_sma_50 = counts_[HAS_SMA_50];
+    breadth.above_sma_50 = counts_[ABOVE_SMA_50];
+    breadth.constituents_priced = constituents_priced_;
+
+    if (index_.weight > 0) {
+        double ratio = index_.weighted_price / index_.weight;
+        breadth.index_change_percent = (ratio - 1.0) * 100.0;
+        if (has_reference_) breadth.index_value = reference_ * ratio;
+    }
+
+    for (size_t sector = 0; sector < SECTOR_COUNT; ++sector) {
+        SectorBreadth& out = breadth.sectors[sector];
+        out.advances = sector_counts_[sector][ADVANCING];
+        out.declines = sector_counts_[sector][DECLINING];
+        out.unchanged = sector_counts_[sector][UNCHANGED];
+        const Totals& totals = sector_totals_[sector];
+        if (totals.weight > 0) out.change_percent = (totals.weighted_price / totals.weight - 1.0) * 100.0;
+    }
+    return breadth;
+}
+
+double MarketBreadthEngine::contribution(SymbolId symbol) const {
+    if (!has_reference_ || symbol >= symbols_.size() || index_.weight <= 0) return 0.0;
+
+    const SymbolState& state = symbols_[symbol];
+    if (!state.priced || state.units <= 0) return 0.0;
+    return reference_ * state.units * (state.price - state.previous_close).toDouble() / index_.weight;
+}
@@ -2,6 +2,48 @@
 #include <sstream>
 #include <iomanip>
 #include <ctime>
+#include <deque>
+#include <mutex>
+#include <numeric>
+#include <algorithm>
+#include <unordered_map>
+
+namespace SymbolTable {
+    
+    namespace {
+        std::mutex table_mutex;
+        std::deque<std::string> symbols;   // deque keeps references stable on growth
+        std::unordered_map<std::string, SymbolId> ids;
+    }
+    
+    SymbolId intern(const std::string& symbol) {
+        std::lock_guard<std::mutex> lock(table_mutex);
+        auto it = ids.find(symbol);
+        if (it != ids.end()) return it->second;
+        
+        SymbolId id = static_cast<SymbolId>(symbols.size());
+        symbols.push_back(symbol);
+        ids.emplace(symbol, id);
+        return id;
+    }
+    
+    SymbolId find(const std::string& symbol) {
+        std::lock_guard<std::mutex> lock(table_mutex);
+        auto it = ids.find(symbol);
+        return it != ids.end() ? it->second : INVALID_SYMBOL_ID;
+    }
+    
+    const std::string& symbol(SymbolId id) {
+        static const std::string unknown = "UNKNOWN";
+        std::lock_guard<std::mutex> lock(table_mutex);
+        return id < symbols.size() ? symbols[id] : unknown;
+    }
+    
+    size_t size() {
+        std::lock_guard<std::mutex> lock(table_mutex);
+        return symbols.size();
+    }
+}
 
 namespace MarketDataUtils {
     
@@ -20,12 +62,107 @@ namespace MarketDataUtils {
         };
     }
     
+    Span<const IndexConstituent> getNifty50Constituents() {
+        // Approximate free-float weights (%) from the NSE index factsheet; the
+        // breadth engine renormalizes over whichever members are priced, so
+        // refresh these at the monthly rebalance rather than exactly
+        static const IndexConstituent constituents[] = {
+            {"RELIANCE.NS", Sector::ENERGY, 10.8}, {"TCS.NS", Sector::IT, 4.4},
+            {"INFY.NS", Sector::IT, 7.0}, {"HDFC.NS", Sector::FINANCIALS, 5.9},
+            {"HDFCBANK.NS", Sector::FINANCIALS, 8.9}, {"ICICIBANK.NS", Sector::FINANCIALS, 7.7},
+            {"KOTAKBANK.NS", Sector::FINANCIALS, 3.4}, {"HINDUNILVR.NS", Sector::FMCG, 2.9},
+            {"LT.NS", Sector::INDUSTRIALS, 3.3}, {"SBIN.NS", Sector::FINANCIALS, 2.6},
+            {"BHARTIARTL.NS", Sector::TELECOM, 2.4}, {"ASIANPAINT.NS", Sector::CONSUMER, 1.6},
+            {"ITC.NS", Sector::FMCG, 4.4}, {"AXISBANK.NS", Sector::FINANCIALS, 3.0},
+            {"MARUTI.NS", Sector::AUTO, 1.5}, {"BAJFINANCE.NS", Sector::FINANCIALS, 2.1},
+            {"NESTLEIND.NS", Sector::FMCG, 0.9}, {"ULTRACEMCO.NS", Sector::MATERIALS, 1.1},
+            {"TITAN.NS", Sector::CONSUMER, 1.4}, {"WIPRO.NS", Sector::IT, 0.6},
+            {"M&M.NS", Sector::AUTO, 1.5}, {"SUNPHARMA.NS", Sector::HEALTHCARE, 1.3},
+            {"TECHM.NS", Sector::IT, 0.8}, {"NTPC.NS", Sector::ENERGY, 1.0},
+            {"POWERGRID.NS", Sector::ENERGY, 1.0}, {"BAJAJFINSV.NS", Sector::FINANCIALS, 0.9},
+            {"HCLTECH.NS", Sector::IT, 1.4}, {"DIVISLAB.NS", Sector::HEALTHCARE, 0.4},
+            {"ADANIENT.NS", Sector::INDUSTRIALS, 0.8}, {"TATAMOTORS.NS", Sector::AUTO, 1.0},
+            {"INDUSINDBK.NS", Sector::FINANCIALS, 0.9}, {"COALINDIA.NS", Sector::ENERGY, 0.6},
+            {"TATASTEEL.NS", Sector::METALS, 1.1}, {"GRASIM.NS", Sector::MATERIALS, 0.8},
+            {"CIPLA.NS", Sector::HEALTHCARE, 0.7}, {"DRREDDY.NS", Sector::HEALTHCARE, 0.7},
+            {"EICHERMOT.NS", Sector::AUTO, 0.6}, {"APOLLOHOSP.NS", Sector::HEALTHCARE, 0.6},
+            {"BRITANNIA.NS", Sector::FMCG, 0.6}, {"BPCL.NS", Sector::ENERGY, 0.4},
+            {"TATACONSUM.NS", Sector::FMCG, 0.6}, {"ADANIPORTS.NS", Sector::INDUSTRIALS, 0.8},
+            {"JSWSTEEL.NS", Sector::METALS, 0.8}, {"HEROMOTOCO.NS", Sector::AUTO, 0.4},
+            {"UPL.NS", Sector::MATERIALS, 0.4}, {"BAJAJ-AUTO.NS", Sector::AUTO, 0.5},
+            {"SBILIFE.NS", Sector::FINANCIALS, 0.7}, {"ONGC.NS", Sector::ENERGY, 0.7},
+            {"HINDALCO.NS", Sector::METALS, 0.9}, {"IOC.NS", Sector::ENERGY, 0.4}
+        };
+        return Span<const IndexConstituent>(constituents, sizeof(constituents) / sizeof(constituents[0]));
+    }
+    
+    const char* sectorToString(Sector sector) {
+        switch (sector) {
+            case Sector::FINANCIALS: return "Financials";
+            case Sector::IT: return "IT";
+            case Sector::ENERGY: return "Energy";
+            case Sector::FMCG: return "FMCG";
+            case Sector::AUTO: return "Auto";
+            case Sector::METALS: return "Metals";
+            case Sector::HEALTHCARE: return "Healthcare";
+            case Sector::INDUSTRIALS: return "Industrials";
+            case Sector::CONSUMER: return "Consumer";
+            case Sector::MATERIALS: return "Materials";
+            case Sector::TELECOM: return "Telecom";
+            default: return "Unclassified";
+        }
+    }
+    
+    MarketScan buildMarketScan(std::shared_ptr<const MarketSnapshot> snapshot, size_t top_n) {
+        MarketScan scan;
+        scan.snapshot = snapshot;
+        if (!snapshot || snapshot->stocks.empty()) return scan;
+        
+        const auto& stocks = snapshot->stocks;
+        std::vector<MarketScan::Index> order(stocks.size());
+        std::iota(order.begin(), order.end(), 0);
+        size_t n = std::min(top_n, order.size());
+        
+        // Rank indices, never the records themselves
+        auto top = [&](auto better) {
+            std::partial_sort(order.begin(), order.begin() + n, order.end(),
+                              [&](MarketScan::Index a, MarketScan::Index b) {
+                                  return better(stocks[a], stocks[b]);
+                              });
+            return std::vector<MarketScan::Index>(order.begin(), order.begin() + n);
+        };
+        
+        scan.top_gainers = top([](const StockData& a, const StockData& b) {
+            return a.change_percent > b.change_percent;
+        });
+        scan.top_losers = top([](const StockData& a, const StockData& b) {
+            return a.change_percent < b.change_percent;
+        });
+        scan.high_volume = top([](const StockData& a, const StockData& b) {
+            return a.volume_ratio > b.volume_ratio;
+        });
+        
+        for (MarketScan::Index i = 0; i < stocks.size(); ++i) {
+            const auto& stock = stocks[i];
+            if (stock.is_breakout) scan.breakout_candidates.push_back(i);
+            if (stock.is_breakdown) scan.breakdown_candidates.push_back(i);
+            if (stock.near_support) scan.near_support.push_back(i);
+            if (stock.near_resistance) scan.near_resistance.push_back(i);
+        }
+        
+        return scan;
+    }
+    
     std::string formatPrice(double price, int decimals) {
         std::ostringstream oss;
         oss << std::fixed << std::setprecision(decimals) << price;
         return oss.str();
     }
     
+    std::string formatPrice(Price price, int decimals) {
+        return formatPrice(price.toDouble(), decimals);
+    }
+    
     std::string formatVolume(long long volume) {
         if (volume >= 10000000) { // 1 Crore
             return formatPrice(volume / 10000000.0, 2) + "Cr";
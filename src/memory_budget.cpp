@@ -0,0 +1,92 @@
+#include "memory_budget.h"
+#include <iomanip>
+#include <sstream>
+
+size_t MemoryBreakdown::total() const {
+    size_t sum = 0;
+    for (size_t value : bytes) sum += value;
+    return sum;
+}
+
+MemoryBudget::MemoryBudget(size_t limit_mb) : limit_bytes_(limit_mb * 1024 * 1024) {
+    for (auto& value : usage_) {
+        value.store(0, std::memory_order_relaxed);
+    }
+}
+
+void MemoryBudget::setLimitMB(size_t limit_mb) {
+    limit_bytes_.store(limit_mb * 1024 * 1024, std::memory_order_relaxed);
+}
+
+void MemoryBudget::report(MemorySubsystem subsystem, size_t bytes) {
+    usage_[static_cast<size_t>(subsystem)].store(bytes, std::memory_order_relaxed);
+}
+
+size_t MemoryBudget::usage(MemorySubsystem subsystem) const {
+    return usage_[static_cast<size_t>(subsystem)].load(std::memory_order_relaxed);
+}
+
+size_t MemoryBudget::totalUsage() const {
+    size_t total = 0;
+    for (const auto& value : usage_) {
+        total += value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+bool MemoryBudget::isNearLimit() const {
+    return totalUsage() >= static_cast<size_t>(limitBytes() * HIGH_WATER_FRACTION);
+}
+
+size_t MemoryBudget::bytesOverTarget() const {
+    size_t target = static_cast<size_t>(limitBytes() * EVICTION_TARGET_FRACTION);
+    size_t total = totalUsage();
+    return total > target ? total - target : 0;
+}
+
+size_t MemoryBudget::bytesUnderTarget() const {
+    size_t target = static_cast<size_t>(limitBytes() * EVICTION_TARGET_FRACTION);
+    size_t total = totalUsage();
+    return total < target ? target - total : 0;
+}
+
+MemoryBreakdown MemoryBudget::breakdown() const {
+    MemoryBreakdown result;
+    for (size_t i = 0; i < MEMORY_SUBSYSTEM_COUNT; ++i) {
+        result.bytes[i] = usage_[i].load(std::memory_order_relaxed);
+    }
+    result.limit_bytes = limitBytes();
+    return result;
+}
+
+namespace MemoryUtils {
+
+    std::string subsystemToString(MemorySubsystem subsystem) {
+        switch (subsystem) {
+            case MemorySubsystem::CANDLES: return "candles";
+            case MemorySubsystem::INDICATORS: return "indicators";
+            case MemorySubsystem::HISTORY: return "history";
+            case MemorySubsystem::GUI: return "gui";
+            default: return "unknown";
+        }
+    }
+
+    std::string formatMegabytes(size_t bytes, int decimals) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(decimals) << bytes / (1024.0 * 1024.0);
+        return oss.str();
+    }
+
+    std::string formatBreakdown(const MemoryBreakdown& breakdown) {
+        std::ostringstream oss;
+        oss << "Memory: " << formatMegabytes(breakdown.total()) << "/"
+            << formatMegabytes(breakdown.limit_bytes, 0) << " MB (";
+        for (size_t i = 0; i < MEMORY_SUBSYSTEM_COUNT; ++i) {
+            if (i > 0) oss << ", ";
+            oss << subsystemToString(static_cast<MemorySubsystem>(i)) << " "
+                << formatMegabytes(breakdown.bytes[i]);
+        }
+        oss << ")";
+        return oss.str();
+    }
+}
@@ -0,0 +1,275 @@
+#include "pairs_scanner.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+PairsScanner::PairsScanner(size_t symbols, size_t window, size_t retest_bars, unsigned workers)
+    : symbols_(0), window_(std::max<size_t>(window, 20)), samples_(0), head_(0),
+      retest_bars_(std::max<size_t>(retest_bars, 1)),
+      bars_since_test_(retest_bars_),   // first test as soon as a pair has a full window
+      workers_(workers > 0 ? workers : std::max(1u, std::thread::hardware_concurrency())),
+      cointegrated_(0), tests_completed_(0) {
+    resize(symbols);
+}
+
+PairsScanner::~PairsScanner() {
+    for (auto& worker : workers_running_) worker.wait();
+}
+
+void PairsScanner::resize(size_t symbols) {
+    if (symbols <= symbols_) return;
+
+    // New lanes have no anchor yet and an all-zero history
+    std::vector<std::int64_t> levels(window_ * symbols, 0);
+    std::vector<std::int64_t> cross(symbols * symbols, 0);
+    for (size_t row = 0; row < window_; ++row) {
+        std::copy_n(levels_.begin() + row * symbols_, symbols_, levels.begin() + row * symbols);
+    }
+    for (size_t i = 0; i < symbols_; ++i) {
+        std::copy_n(cross_.begin() + i * symbols_, symbols_, cross.begin() + i * symbols);
+    }
+
+    levels_.swap(levels);
+    cross_.swap(cross);
+    anchor_log_.resize(symbols, 0);
+    seen_.resize(symbols, 0);
+    last_level_.resize(symbols, 0);
+    sum_.resize(symbols, 0);
+    removed_.resize(symbols, 0);
+    symbols_ = symbols;
+}
+
+void PairsScanner::update(Span<const std::int32_t> closes) {
+    if (symbols_ == 0) return;
+
+    // The oldest row is overwritten in place; keep a copy to subtract
+    std::int64_t* row = levels_.data() + head_ * symbols_;
+    std::copy_n(row, symbols_, removed_.begin());
+
+    const double limit = 2.0 * LEVEL_SCALE;
+    for (size_t i = 0; i < symbols_; ++i) {
+        std::int32_t close = i < closes.size() ? closes[i] : 0;
+        if (close > 0) {
+            double log_close = std::log(close / 100.0);
+            if (seen_[i] == 0) anchor_log_[i] = log_close;
+            // Clamped to e^+/-2 of the anchor so window sums of products stay in int64
+            double level = std::max(-limit, std::min(limit, (log_close - anchor_log_[i]) * LEVEL_SCALE));
+            last_level_[i] = std::llround(level);
+        }
+        if (seen_[i] > 0 || close > 0) seen_[i] = std::min(seen_[i] + 1, window_);
+
+        row[i] = last_level_[i];
+        sum_[i] += row[i] - removed_[i];
+    }
+
+    for (size_t i = 0; i < symbols_; ++i) {
+        std::int64_t a = row[i];
+        std::int64_t r = removed_[i];
+        if (a == 0 && r == 0) continue;
+
+        std::int64_t* cross_row = cross_.data() + i * symbols_;
+        for (size_t j = i; j < symbols_; ++j) {
+            cross_row[j] += a * row[j] - r * removed_[j];
+        }
+    }
+
+    head_ = (head_ + 1 == window_) ? 0 : head_ + 1;
+    if (samples_ < window_) ++samples_;
+
+    collectTests();
+    if (++bars_since_test_ >= retest_bars_ && !testing()) startTests();
+}
+
+std::int64_t PairsScanner::crossSum(SymbolId a, SymbolId b) const {
+    return cross_[std::min(a, b) * symbols_ + std::max(a, b)];
+}
+
+bool PairsScanner::ready(SymbolId a, SymbolId b) const {
+    return a < symbols_ && b < symbols_ && a != b && seen_[a] >= window_ && seen_[b] >= window_;
+}
+
+PairStats PairsScanner::pair(SymbolId a, SymbolId b) const {
+    PairStats stats;
+    stats.a = a;
+    stats.b = b;
+    if (!ready(a, b)) return stats;
+
+    // Exact in int64: n * sum(x^2) - sum(x)^2 etc.
+    const std::int64_t n = static_cast<std::int64_t>(window_);
+    std::int64_t variance_x = n * crossSum(b, b) - sum_[b] * sum_[b];
+    std::int64_t variance_y = n * crossSum(a, a) - sum_[a] * sum_[a];
+    std::int64_t covariance = n * crossSum(a, b) - sum_[a] * sum_[b];
+    if (variance_x <= 0) return stats;
+
+    double beta = static_cast<double>(covariance) / variance_x;
+    double alpha = (sum_[a] - beta * sum_[b]) / n;
+    double residual_squares = (variance_y - beta * covariance) / n;
+    double sigma = std::sqrt(std::max(0.0, residual_squares) / (n - 2));
+
+    stats.hedge_ratio = beta;
+    stats.intercept = anchor_log_[a] + alpha / LEVEL_SCALE - beta * anchor_log_[b];
+    stats.spread_sigma = sigma / LEVEL_SCALE;
+    if (sigma > 0) stats.z_score = (last_level_[a] - alpha - beta * last_level_[b]) / sigma;
+
+    if (const CointegrationTest* tested = test(a, b)) {
+        stats.adf_t = tested->adf_t;
+        stats.half_life = tested->half_life;
+        stats.cointegrated = tested->cointegrated;
+    }
+    return stats;
+}
+
+const CointegrationTest* PairsScanner::test(SymbolId a, SymbolId b) const {
+    SymbolId low = std::min(a, b);
+    SymbolId high = std::max(a, b);
+    auto it = std::lower_bound(tests_.begin(), tests_.end(), std::make_pair(low, high),
+                               [](const CointegrationTest& test, const std::pair<SymbolId, SymbolId>& key) {
+                                   return test.a != key.first ? test.a < key.first : test.b < key.second;
+                               });
+    return (it != tests_.end() && it->a == low && it->b == high) ? &*it : nullptr;
+}
+
+std::vector<PairStats> PairsScanner::opportunities(double entry_z) const {
+    std::vector<PairStats> found;
+    for (const auto& tested : tests_) {
+        if (!tested.cointegrated || tested.half_life <= 0 || tested.half_life > window_ / 2.0) continue;
+
+        PairStats stats = pair(tested.a, tested.b);
+        if (stats.hedge_ratio > 0 && std::abs(stats.z_score) >= entry_z) found.push_back(stats);
+    }
+    std::sort(found.begin(), found.end(), [](const PairStats& x, const PairStats& y) {
+        return std::abs(x.z_score) > std::abs(y.z_score);
+    });
+    return found;
+}
+
+void PairsScanner::collectTests() {
+    if (workers_running_.empty()) return;
+    for (auto& worker : workers_running_) {
+        if (worker.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+    }
+
+    for (auto& worker : workers_running_) worker.get();
+    workers_running_.clear();
+    tests_.swap(job_->results);
+    job_.reset();
+
+    cointegrated_ = static_cast<size_t>(std::count_if(tests_.begin(), tests_.end(),
+                                                      [](const CointegrationTest& test) { return test.cointegrated; }));
+    ++tests_completed_;
+}
+
+void PairsScanner::waitForTests() {
+    for (auto& worker : workers_running_) worker.wait();
+    collectTests();
+}
+
+void PairsScanner::startTests() {
+    auto job = std::make_shared<TestJob>();
+    job->symbols = symbols_;
+    job->window = window_;
+    for (SymbolId a = 0; a < symbols_; ++a) {
+        for (SymbolId b = a + 1; b < symbols_; ++b) {
+            if (!ready(a, b)) continue;
+            CointegrationTest test;
+            test.a = a;
+            test.b = b;
+            job->results.push_back(test);
+        }
+    }
+    if (job->results.empty()) return;
+
+    // Snapshot the window oldest first; the workers never touch live state
+    job->levels.resize(window_ * symbols_);
+    for (size_t row = 0; row < window_; ++row) {
+        size_t from = (head_ + row) % window_;
+        std::copy_n(levels_.begin() + from * symbols_, symbols_, job->levels.begin() + row * symbols_);
+    }
+
+    size_t pairs = job->results.size();
+    size_t tasks = std::min<size_t>(workers_, pairs);
+    size_t chunk = (pairs + tasks - 1) / tasks;
+    for (size_t begin = 0; begin < pairs; begin += chunk) {
+        size_t end = std::min(pairs, begin + chunk);
+        workers_running_.push_back(std::async(std::launch::async, [job, begin, end]() {
+            runTests(*job, begin, end);
+        }));
+    }
+    job_ = std::move(job);
+    bars_since_test_ = 0;
+}
+
+void PairsScanner::runTests(TestJob& job, size_t begin, size_t end) {
+    const size_t n = job.window;
+    std::vector<double> residuals(n);
+
+    for (size_t k = begin; k < end; ++k) {
+        CointegrationTest& test = job.results[k];
+        const std::int64_t* y = job.levels.data() + test.a;
+        const std::int64_t* x = job.levels.data() + test.b;
+        const size_t stride = job.symbols;
+
+        // OLS of a on b, centred
+        double mean_x = 0, mean_y = 0;
+        for (size_t t = 0; t < n; ++t) {
+            mean_x += x[t * stride];
+            mean_y += y[t * stride];
+        }
+        mean_x /= n;
+        mean_y /= n;
+
+        double sxx = 0, sxy = 0;
+        for (size_t t = 0; t < n; ++t) {
+            double dx = x[t * stride] - mean_x;
+            sxx += dx * dx;
+            sxy += dx * (y[t * stride] - mean_y);
+        }
+        if (sxx <= 0) continue;
+
+        double beta = sxy / sxx;
+        for (size_t t = 0; t < n; ++t) {
+            residuals[t] = (y[t * stride] - mean_y) - beta * (x[t * stride] - mean_x);
+        }
+
+        // ADF(1) without constant: de[t] = gamma * e[t-1] + phi * de[t-1] + u
+        double lag_lag = 0, lag_diff = 0, diff_diff = 0, lag_dy = 0, diff_dy = 0, dy_dy = 0;
+        for (size_t t = 2; t < n; ++t) {
+            double lag = residuals[t - 1];
+            double lag_change = residuals[t - 1] - residuals[t - 2];
+            double change = residuals[t] - residuals[t - 1];
+            lag_lag += lag * lag;
+            lag_diff += lag * lag_change;
+            diff_diff += lag_change * lag_change;
+            lag_dy += lag * change;
+            diff_dy += lag_change * change;
+            dy_dy += change * change;
+        }
+        double det = lag_lag * diff_diff - lag_diff * lag_diff;
+        if (det <= 0) continue;
+
+        double gamma = (diff_diff * lag_dy - lag_diff * diff_dy) / det;
+        double phi = (lag_lag * diff_dy - lag_diff * lag_dy) / det;
+        double ssr = std::max(0.0, dy_dy - gamma * lag_dy - phi * diff_dy);
+        double variance = ssr / static_cast<double>(n - 4);
+        double standard_error = std::sqrt(variance * diff_diff / det);
+        if (standard_error <= 0) continue;
+
+        test.hedge_ratio = beta;
+        test.adf_t = gamma / standard_error;
+        test.half_life = (gamma < 0 && gamma > -1) ? -std::log(2.0) / std::log1p(gamma) : 0.0;
+        test.cointegrated = test.adf_t < CRITICAL_T_5 && beta > 0;
+    }
+}
+
+size_t PairsScanner::memoryBytes() const {
+    size_t bytes = anchor_log_.capacity() * sizeof(double) + seen_.capacity() * sizeof(size_t) +
+                   (last_level_.capacity() + levels_.capacity() + sum_.capacity() + cross_.capacity() +
+                    removed_.capacity()) * sizeof(std::int64_t) +
+                   tests_.capacity() * sizeof(CointegrationTest);
+    if (job_) {
+        bytes += job_->levels.capacity() * sizeof(std::int64_t) +
+                 job_->results.capacity() * sizeof(CointegrationTest);
+    }
+    return bytes;
+}
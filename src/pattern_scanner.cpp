@@ -0,0 +1,188 @@
+#include "pattern_scanner.h"
+#include <algorithm>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define HFT_PATTERN_AVX2 1
+#include <immintrin.h>
+#endif
+
+PatternScanner::PatternScanner(size_t lookback, double doji_threshold)
+    : lookback_(std::max<size_t>(lookback, 1)), doji_threshold_(doji_threshold),
+      kernel_(IndicatorBatch::bestKernel()) {}
+
+void PatternScanner::scan(const std::vector<CandleSpan>& universe) {
+    size_t total = 0;
+    for (const auto& bars : universe) {
+        total += std::min(bars.size(), lookback_);
+    }
+
+    // Sized to the universe once; later scans reuse the capacity
+    open_.resize(total);
+    high_.resize(total);
+    low_.resize(total);
+    close_.resize(total);
+    prev_open_.resize(total);
+    prev_close_.resize(total);
+    masks_.resize(total);
+    offsets_.clear();
+    offsets_.push_back(0);
+
+    size_t at = 0;
+    for (const auto& bars : universe) {
+        size_t first = bars.size() - std::min(bars.size(), lookback_);
+        for (size_t k = first; k < bars.size(); ++k, ++at) {
+            const OHLCV& bar = bars[k];
+            // No predecessor: a bar cannot engulf itself
+            const OHLCV& prev = k > 0 ? bars[k - 1] : bar;
+            open_[at] = bar.open.paise;
+            high_[at] = bar.high.paise;
+            low_[at] = bar.low.paise;
+            close_[at] = bar.close.paise;
+            prev_open_[at] = prev.open.paise;
+            prev_close_[at] = prev.close.paise;
+        }
+        offsets_.push_back(at);
+    }
+
+    if (kernel_ == BatchKernel::AVX2) {
+        scanAVX2();
+    } else {
+        scanScalar(0, total);
+    }
+}
+
+void PatternScanner::scanScalar(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        std::int32_t open = open_[i];
+        std::int32_t close = close_[i];
+        std::int32_t body = close > open ? close - open : open - close;
+        std::int32_t lower = std::min(open, close) - low_[i];
+        std::int32_t upper = high_[i] - std::max(open, close);
+        std::int32_t range = high_[i] - low_[i];
+        std::int32_t prev_open = prev_open_[i];
+        std::int32_t prev_close = prev_close_[i];
+
+        PatternMask mask = CandlePattern::NONE;
+        // Same arithmetic as TechnicalIndicators::isDoji, in rupees
+        if (range != 0 && (body / 100.0) / (range / 100.0) < doji_threshold_) {
+            mask |= CandlePattern::DOJI;
+        }
+        if (lower > body * 2 && upper * 2 < body) mask |= CandlePattern::HAMMER;
+        if (upper > body * 2 && lower * 2 < body) mask |= CandlePattern::SHOOTING_STAR;
+        if (prev_close < prev_open && close > open && open < prev_close && close > prev_open) {
+            mask |= CandlePattern::BULLISH_ENGULFING;
+        }
+        if (prev_close > prev_open && close < open && open > prev_close && close < prev_open) {
+            mask |= CandlePattern::BEARISH_ENGULFING;
+        }
+        masks_[i] = mask;
+    }
+}
+
+#ifdef HFT_PATTERN_AVX2
+__attribute__((target("avx2")))
+void PatternScanner::scanAVX2() {
+    const size_t total = masks_.size();
+    const __m256i hammer_bit = _mm256_set1_epi32(CandlePattern::HAMMER);
+    const __m256i star_bit = _mm256_set1_epi32(CandlePattern::SHOOTING_STAR);
+    const __m256i bullish_bit = _mm256_set1_epi32(CandlePattern::BULLISH_ENGULFING);
+    const __m256i bearish_bit = _mm256_set1_epi32(CandlePattern::BEARISH_ENGULFING);
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d threshold = _mm256_set1_pd(doji_threshold_);
+    const __m256d zero = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 8 <= total; i += 8) {
+        __m256i open = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(open_.data() + i));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(high_.data() + i));
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(low_.data() + i));
+        __m256i close = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(close_.data() + i));
+        __m256i prev_open = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev_open_.data() + i));
+        __m256i prev_close = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev_close_.data() + i));
+
+        __m256i body = _mm256_abs_epi32(_mm256_sub_epi32(close, open));
+        __m256i lower = _mm256_sub_epi32(_mm256_min_epi32(open, close), low);
+        __m256i upper = _mm256_sub_epi32(high, _mm256_max_epi32(open, close));
+        __m256i body_2 = _mm256_add_epi32(body, body);
+
+        __m256i hammer = _mm256_and_si256(_mm256_cmpgt_epi32(lower, body_2),
+                                          _mm256_cmpgt_epi32(body, _mm256_add_epi32(upper, upper)));
+        __m256i star = _mm256_and_si256(_mm256_cmpgt_epi32(upper, body_2),
+                                        _mm256_cmpgt_epi32(body, _mm256_add_epi32(lower, lower)));
+
+        __m256i green = _mm256_cmpgt_epi32(close, open);
+        __m256i red = _mm256_cmpgt_epi32(open, close);
+        __m256i prev_green = _mm256_cmpgt_epi32(prev_close, prev_open);
+        __m256i prev_red = _mm256_cmpgt_epi32(prev_open, prev_close);
+        __m256i bullish = _mm256_and_si256(_mm256_and_si256(prev_red, green),
+                                           _mm256_and_si256(_mm256_cmpgt_epi32(prev_close, open),
+                                                            _mm256_cmpgt_epi32(close, prev_open)));
+        __m256i bearish = _mm256_and_si256(_mm256_and_si256(prev_green, red),
+                                           _mm256_and_si256(_mm256_cmpgt_epi32(open, prev_close),
+                                                            _mm256_cmpgt_epi32(prev_open, close)));
+
+        __m256i mask = _mm256_or_si256(
+            _mm256_or_si256(_mm256_and_si256(hammer, hammer_bit), _mm256_and_si256(star, star_bit)),
+            _mm256_or_si256(_mm256_and_si256(bullish, bullish_bit), _mm256_and_si256(bearish, bearish_bit)));
+
+        // Doji divides in double like isDoji, four bars per half
+        __m256i range = _mm256_sub_epi32(high, low);
+        int doji = 0;
+        for (int half = 0; half < 2; ++half) {
+            __m128i body_half = half == 0 ? _mm256_castsi256_si128(body) : _mm256_extracti128_si256(body, 1);
+            __m128i range_half = half == 0 ? _mm256_castsi256_si128(range) : _mm256_extracti128_si256(range, 1);
+            __m256d body_rupees = _mm256_div_pd(_mm256_cvtepi32_pd(body_half), hundred);
+            __m256d range_rupees = _mm256_div_pd(_mm256_cvtepi32_pd(range_half), hundred);
+            __m256d is_doji = _mm256_and_pd(
+                _mm256_cmp_pd(_mm256_div_pd(body_rupees, range_rupees), threshold, _CMP_LT_OQ),
+                _mm256_cmp_pd(range_rupees, zero, _CMP_NEQ_OQ));
+            doji |= _mm256_movemask_pd(is_doji) << (half * 4);
+        }
+
+        alignas(32) std::int32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), mask);
+        for (int lane = 0; lane < 8; ++lane) {
+            masks_[i + lane] = static_cast<PatternMask>(lanes[lane]) |
+                               (((doji >> lane) & 1) ? CandlePattern::DOJI : CandlePattern::NONE);
+        }
+    }
+    scanScalar(i, total);
+}
+#else
+void PatternScanner::scanAVX2() {
+    scanScalar(0, masks_.size());
+}
+#endif
+
+Span<const PatternMask> PatternScanner::masks(SymbolId symbol) const {
+    if (static_cast<size_t>(symbol) + 1 >= offsets_.size()) return Span<const PatternMask>();
+    size_t begin = offsets_[symbol];
+    return Span<const PatternMask>(masks_.data() + begin, offsets_[symbol + 1] - begin);
+}
+
+PatternMask PatternScanner::latest(SymbolId symbol, size_t bars_back) const {
+    auto bars = masks(symbol);
+    return bars_back < bars.size() ? bars[bars.size() - 1 - bars_back] : CandlePattern::NONE;
+}
+
+size_t PatternScanner::memoryBytes() const {
+    return (open_.capacity() + high_.capacity() + low_.capacity() + close_.capacity() +
+            prev_open_.capacity() + prev_close_.capacity()) * sizeof(std::int32_t) +
+           masks_.capacity() * sizeof(PatternMask) + offsets_.capacity() * sizeof(size_t);
+}
+
+void PatternScanner::setKernel(BatchKernel kernel) {
+    kernel_ = (kernel == BatchKernel::AVX2 && IndicatorBatch::bestKernel() != BatchKernel::AVX2)
+                  ? BatchKernel::SCALAR : kernel;
+}
+
+const char* PatternScanner::patternName(PatternMask pattern) {
+    switch (pattern) {
+        case CandlePattern::DOJI: return "Doji";
+        case CandlePattern::HAMMER: return "Hammer";
+        case CandlePattern::SHOOTING_STAR: return "Shooting Star";
+        case CandlePattern::BULLISH_ENGULFING: return "Bullish Engulfing";
+        case CandlePattern::BEARISH_ENGULFING: return "Bearish Engulfing";
+        default: return "None";
+    }
+}
@@ -0,0 +1,71 @@
+#include "price.h"
+#include <ostream>
+#include <iomanip>
+#include <cstdlib>
+
+std::ostream& operator<<(std::ostream& os, Price price) {
+    std::int64_t paise = price.paise;
+    if (paise < 0) {
+        os << '-';
+        paise = -paise;
+    }
+    os << paise / 100 << '.' << std::setw(2) << std::setfill('0') << paise % 100 << std::setfill(' ');
+    return os;
+}
+
+namespace PriceUtils {
+
+    Price tickSizeFor(Price price) {
+        // NSE equity price-band tick sizes (in paise)
+        std::int32_t p = std::abs(price.paise);
+        if (p < 250 * 100) return Price::fromPaise(1);
+        if (p < 1000 * 100) return Price::fromPaise(5);
+        if (p < 5000 * 100) return Price::fromPaise(10);
+        if (p < 10000 * 100) return Price::fromPaise(50);
+        if (p < 20000 * 100) return Price::fromPaise(100);
+        return Price::fromPaise(500);
+    }
+
+    Price roundToTick(Price price) {
+        std::int64_t tick = tickSizeFor(price).paise;
+        std::int64_t p = price.paise;
+        std::int64_t rounded = (p >= 0 ? (p + tick / 2) / tick : -((-p + tick / 2) / tick)) * tick;
+        return Price::fromPaise(rounded);
+    }
+
+    Price floorToTick(Price price) {
+        std::int64_t tick = tickSizeFor(price).paise;
+        std::int64_t p = price.paise;
+        std::int64_t q = p / tick;
+        if (p < 0 && q * tick != p) --q;
+        return Price::fromPaise(q * tick);
+    }
+
+    Price ceilToTick(Price price) {
+        std::int64_t tick = tickSizeFor(price).paise;
+        std::int64_t p = price.paise;
+        std::int64_t q = p / tick;
+        if (p > 0 && q * tick != p) ++q;
+        return Price::fromPaise(q * tick);
+    }
+
+    Price scaleToTick(Price price, double factor) {
+        return roundToTick(Price::fromRupees(price.toDouble() * factor));
+    }
+
+    bool isAboveByBps(Price price, Price level, int basis_points) {
+        return static_cast<std::int64_t>(price.paise) * 10000 >
+               static_cast<std::int64_t>(level.paise) * (10000 + basis_points);
+    }
+
+    bool isBelowByBps(Price price, Price level, int basis_points) {
+        return static_cast<std::int64_t>(price.paise) * 10000 <
+               static_cast<std::int64_t>(level.paise) * (10000 - basis_points);
+    }
+
+    bool isWithinBps(Price price, Price level, int basis_points) {
+        if (!level.isPositive()) return false;
+        std::int64_t diff = std::abs(static_cast<std::int64_t>(price.paise) - level.paise);
+        return diff * 10000 < static_cast<std::int64_t>(level.paise) * basis_points;
+    }
+}
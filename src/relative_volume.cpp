@@ -0,0 +1,113 @@
+#include "relative_volume.h"
+#include <algorithm>
+#include <cmath>
+
+RelativeVolumeEngine::Profile::Profile()
+    : sessions(0), minute(-1), before_newest(0), cumulative(0) {
+    expected.fill(0.0);
+    today.fill(0);
+}
+
+RelativeVolumeEngine::RelativeVolumeEngine(int sessions) : sessions_(std::max(sessions, 1)) {
+}
+
+void RelativeVolumeEngine::update(SymbolId symbol, const OHLCV& bar) {
+    using Days = std::chrono::duration<std::int64_t, std::ratio<86400>>;
+
+    auto& profile = profileFor(symbol);
+    if (profile.minute >= 0 && bar.timestamp < profile.newest) return;
+
+    auto day = std::chrono::floor<Days>(bar.timestamp.time_since_epoch());
+    std::chrono::system_clock::time_point open(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(day + AnchoredVWAP::SESSION_OPEN_UTC));
+    auto minute = static_cast<int>(std::chrono::floor<std::chrono::minutes>(bar.timestamp - open).count());
+    if (minute < 0 || minute >= SESSION_MINUTES) return;
+
+    if (open != profile.session_open) {
+        if (profile.minute >= 0) closeSession(profile);
+        profile.session_open = open;
+        profile.minute = -1;
+        profile.before_newest = 0;
+        profile.cumulative = 0;
+    }
+
+    if (profile.minute >= 0 && bar.timestamp == profile.newest) {
+        // In-progress bar revised
+        profile.cumulative = profile.before_newest + bar.volume;
+    } else {
+        // Minutes without a bar traded nothing
+        for (int m = profile.minute + 1; m < minute; ++m) {
+            profile.today[m] = profile.cumulative;
+        }
+        profile.before_newest = profile.cumulative;
+        profile.cumulative += bar.volume;
+        profile.minute = minute;
+        profile.newest = bar.timestamp;
+    }
+    profile.today[profile.minute] = profile.cumulative;
+}
+
+void RelativeVolumeEngine::update(SymbolId symbol, CandleSpan bars) {
+    for (const auto& bar : bars) {
+        update(symbol, bar);
+    }
+}
+
+double RelativeVolumeEngine::ratio(SymbolId symbol) const {
+    if (symbol >= profiles_.size()) return 1.0;
+
+    const auto& profile = profiles_[symbol];
+    if (profile.sessions == 0 || profile.minute < 0) return 1.0;
+
+    double expected = profile.expected[profile.minute];
+    return expected > 0 ? static_cast<double>(profile.cumulative) / expected : 1.0;
+}
+
+Quantity RelativeVolumeEngine::expectedVolume(SymbolId symbol) const {
+    if (symbol >= profiles_.size()) return 0;
+
+    const auto& profile = profiles_[symbol];
+    if (profile.sessions == 0 || profile.minute < 0) return 0;
+    return static_cast<Quantity>(std::llround(profile.expected[profile.minute]));
+}
+
+Quantity RelativeVolumeEngine::sessionVolume(SymbolId symbol) const {
+    return symbol < profiles_.size() ? profiles_[symbol].cumulative : 0;
+}
+
+int RelativeVolumeEngine::sessionsSeen(SymbolId symbol) const {
+    return symbol < profiles_.size() ? profiles_[symbol].sessions : 0;
+}
+
+void RelativeVolumeEngine::apply(SymbolId symbol, StockData& stock) const {
+    if (sessionsSeen(symbol) == 0) return;
+
+    stock.avg_volume = expectedVolume(symbol);
+    stock.volume_ratio = ratio(symbol);
+    stock.volume_spike = stock.volume_ratio > 1.5;
+}
+
+size_t RelativeVolumeEngine::memoryBytes() const {
+    return profiles_.capacity() * sizeof(Profile);
+}
+
+RelativeVolumeEngine::Profile& RelativeVolumeEngine::profileFor(SymbolId symbol) {
+    if (symbol >= profiles_.size()) {
+        profiles_.resize(static_cast<size_t>(symbol) + 1);
+    }
+    return profiles_[symbol];
+}
+
+void RelativeVolumeEngine::closeSession(Profile& profile) const {
+    // Nothing traded after the last bar (an early close, a halt)
+    for (int m = profile.minute + 1; m < SESSION_MINUTES; ++m) {
+        profile.today[m] = profile.cumulative;
+    }
+
+    // Running mean over the first sessions_, then weight 1/sessions_
+    if (profile.sessions < sessions_) ++profile.sessions;
+    double weight = 1.0 / profile.sessions;
+    for (int m = 0; m < SESSION_MINUTES; ++m) {
+        profile.expected[m] += (profile.today[m] - profile.expected[m]) * weight;
+    }
+}
@@ -192,14 +192,14 @@ void SimpleHFTGui::updateStockList() {
         
         // Determine status
         std::string status = "Active";
-        if (stock.current_price <= 0) status = "No Data";
+        if (!stock.current_price.isPositive()) status = "No Data";
         else if (stock.volume == 0) status = "Low Vol";
         
         // Create row
         std::vector<tgui::String> row = {
             clean_symbol,
-            formatPrice(stock.current_price),
-            (stock.change >= 0 ? "+" : "") + formatPrice(stock.change),
+            formatPrice(stock.current_price.toDouble()),
+            (stock.change >= Price() ? "+" : "") + formatPrice(stock.change.toDouble()),
             (stock.change_percent >= 0 ? "+" : "") + formatPercent(stock.change_percent),
             std::to_string((long long)stock.volume),
             std::to_string((int)stock.rsi_14),
@@ -211,9 +211,9 @@ void SimpleHFTGui::updateStockList() {
         
         // Set row color based on change
         int item_index = stock_list_->getItemCount() - 1;
-        if (stock.change > 0) {
+        if (stock.change.isPositive()) {
             stock_list_->setItemColor(item_index, tgui::Color(0, 255, 0, 50));
-        } else if (stock.change < 0) {
+        } else if (stock.change < Price()) {
             stock_list_->setItemColor(item_index, tgui::Color(255, 0, 0, 50));
         }
     }
@@ -1,5 +1,9 @@
 #include "strategy_engine.h"
+#include "allocation_stats.h"
+#include "correlation_matrix.h"
+#include "pairs_scanner.h"
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <iostream>
 
@@ -7,7 +11,8 @@
 StrategyEngine::StrategyEngine() 
     : global_confidence_threshold_(0.6), 
       min_risk_reward_ratio_(1.5), 
-      max_signals_per_stock_(3) {
+      max_signals_per_stock_(3),
+      max_correlation_(0.7) {
     initializeDefaultStrategies();
 }
 
@@ -19,6 +24,7 @@ void StrategyEngine::initializeDefaultStrategies() {
     addStrategy(std::make_unique<RSIStrategy>());
     addStrategy(std::make_unique<BreakoutStrategy>());
     addStrategy(std::make_unique<VolumeStrategy>());
+    strategy_enabled_[pairs_strategy_.getName()] = true;
     
     std::cout << "✅ Strategy engine initialized with " << strategies_.size() 
               << " strategies" << std::endl;
@@ -30,67 +36,150 @@ void StrategyEngine::addStrategy(std::unique_ptr<BaseStrategy> strategy) {
     strategy_enabled_[name] = true;
 }
 
-std::vector<TradingSignal> StrategyEngine::analyzeStock(const StockData& stock, 
-                                                       const HistoricalData& historical) {
-    std::vector<TradingSignal> all_signals;
+void StrategyEngine::beginCycle() {
+    // Drop last cycle's containers before their arena memory is released
+    cycle_signals_ = SignalList(cycle_arena_.resource());
+    cycle_setups_ = SetupList(cycle_arena_.resource());
+    cycle_arena_.reset();
+}
+
+void StrategyEngine::analyzeStock(const StockData& stock, const HistoricalData& historical,
+                                  SignalList& out) {
+    // Quarantined bad print: nothing to trade on until a clean bar arrives
+    if (stock.anomaly == AnomalyType::BAD_PRINT) return;
+    // Escalated once, on the fetch that brought the bar in
+    if (stock.anomaly != AnomalyType::NONE && stock.anomaly_new) {
+        AnomalyAlert alert;
+        alert.symbol = stock.symbol_id;
+        alert.type = stock.anomaly;
+        alert.z_score = stock.anomaly_z;
+        alert.price = stock.current_price;
+        alert.change_percent = stock.change_percent;
+        alerts_.push_back(alert);
+    }
+    
+    const size_t first = out.size();
     
     for (const auto& strategy : strategies_) {
         if (!strategy_enabled_[strategy->getName()]) continue;
         
         if (strategy->isApplicable(stock)) {
-            auto signals = strategy->analyze(stock, historical);
-            for (auto& signal : signals) {
-                updateSignalMetrics(signal, stock);
-                if (signal.confidence >= strategy->getMinConfidenceThreshold()) {
-                    all_signals.push_back(signal);
-                }
+            const size_t begin = out.size();
+            strategy->analyze(stock, historical, out);
+            for (size_t i = begin; i < out.size(); ++i) {
+                updateSignalMetrics(out[i], stock);
             }
+            
+            double min_confidence = strategy->getMinConfidenceThreshold();
+            out.erase(std::remove_if(out.begin() + begin, out.end(),
+                                     [min_confidence](const TradingSignal& signal) {
+                                         return signal.confidence < min_confidence;
+                                     }),
+                      out.end());
         }
     }
     
     // Limit signals per stock
-    if (all_signals.size() > static_cast<size_t>(max_signals_per_stock_)) {
-        std::sort(all_signals.begin(), all_signals.end(),
+    if (out.size() - first > static_cast<size_t>(max_signals_per_stock_)) {
+        std::sort(out.begin() + first, out.end(),
                  [](const TradingSignal& a, const TradingSignal& b) {
                      return a.confidence > b.confidence;
                  });
-        all_signals.resize(max_signals_per_stock_);
+        out.erase(out.begin() + first + max_signals_per_stock_, out.end());
     }
+}
+
+std::vector<AnomalyAlert> StrategyEngine::takeAlerts() {
+    std::vector<AnomalyAlert> taken;
+    taken.swap(alerts_);
+    return taken;
+}
+
+void StrategyEngine::analyzePairs(const PairsScanner& pairs, const MarketSnapshot& snapshot,
+                                  std::vector<TradingSetup>& setups) {
+    if (!strategy_enabled_[pairs_strategy_.getName()]) return;
     
-    return all_signals;
+    SignalList legs(cycle_arena_.resource());
+    std::vector<std::uint8_t> used(snapshot.slot_by_id.size(), 0);
+    
+    for (const auto& pair : pairs.opportunities(pairs_strategy_.getEntryZ())) {
+        int slot_a = snapshot.indexOf(pair.a);
+        int slot_b = snapshot.indexOf(pair.b);
+        if (slot_a < 0 || slot_b < 0 || used[pair.a] || used[pair.b]) continue;
+        
+        const auto& a = snapshot.stocks[slot_a];
+        const auto& b = snapshot.stocks[slot_b];
+        // A leg on a bad print makes the spread itself suspect
+        if (a.anomaly == AnomalyType::BAD_PRINT || b.anomaly == AnomalyType::BAD_PRINT) continue;
+        
+        legs.clear();
+        pairs_strategy_.analyze(pair, a, b, legs);
+        if (legs.size() < 2) continue;
+        updateSignalMetrics(legs[0], a);
+        updateSignalMetrics(legs[1], b);
+        
+        const auto& symbol_a = snapshot.info[slot_a].symbol;
+        const auto& symbol_b = snapshot.info[slot_b].symbol;
+        auto setup = combineSignalsToSetup(symbol_a, legs);
+        setup.setup_name = symbol_a.substr(0, symbol_a.find('.')) + "/" + symbol_b.substr(0, symbol_b.find('.'));
+        // The second leg is the hedge, not a confirming signal
+        setup.overall_confidence = legs[0].confidence;
+        setup.setup_validity_minutes = std::max(5, static_cast<int>(std::ceil(pair.half_life * 2)));
+        setup.best_entry_time = "While the spread is stretched";
+        
+        used[pair.a] = used[pair.b] = 1;
+        setups.push_back(std::move(setup));
+    }
 }
 
-std::vector<TradingSetup> StrategyEngine::generateSetups(const std::vector<StockData>& stocks,
-                                                        const std::map<std::string, HistoricalData>& historical_data) {
-    std::vector<TradingSetup> setups;
+const SetupList& StrategyEngine::generateSetups(const std::vector<StockData>& stocks,
+                                                const std::map<std::string, HistoricalData>& historical_data) {
+    auto heap_start = AllocationStats::current();
+    beginCycle();
+    
+    AnalysisCycleStats stats;
+    cycle_setups_.reserve(stocks.size());
     
     for (const auto& stock : stocks) {
-        auto hist_it = historical_data.find(stock.symbol);
+        const std::string& symbol = SymbolTable::symbol(stock.symbol_id);
+        auto hist_it = historical_data.find(symbol);
         if (hist_it == historical_data.end()) continue;
         
-        auto signals = analyzeStock(stock, hist_it->second);
-        if (!signals.empty()) {
-            auto setup = combineSignalsToSetup(stock.symbol, signals);
+        cycle_signals_.clear();
+        analyzeStock(stock, hist_it->second, cycle_signals_);
+        ++stats.stocks_analyzed;
+        stats.signals_generated += cycle_signals_.size();
+        
+        if (!cycle_signals_.empty()) {
+            auto setup = combineSignalsToSetup(symbol, cycle_signals_, cycle_arena_.resource());
             if (isHighQualitySetup(setup)) {
-                setups.push_back(setup);
+                cycle_setups_.push_back(std::move(setup));
             }
         }
     }
     
     // Sort by confidence
-    std::sort(setups.begin(), setups.end(),
+    std::sort(cycle_setups_.begin(), cycle_setups_.end(),
              [](const TradingSetup& a, const TradingSetup& b) {
                  return a.overall_confidence > b.overall_confidence;
              });
     
-    return setups;
+    auto heap_used = AllocationStats::since(heap_start);
+    stats.setups_generated = cycle_setups_.size();
+    stats.arena_bytes = cycle_arena_.bytesUsed();
+    stats.heap_allocations = heap_used.allocations;
+    stats.heap_bytes = heap_used.bytes;
+    last_cycle_stats_ = stats;
+    
+    return cycle_setups_;
 }
 
 TradingSetup StrategyEngine::combineSignalsToSetup(const std::string& symbol,
-                                                  const std::vector<TradingSignal>& signals) {
-    TradingSetup setup;
+                                                  Span<const TradingSignal> signals,
+                                                  std::pmr::memory_resource* resource) {
+    TradingSetup setup(resource);
     setup.symbol = symbol;
-    setup.supporting_signals = signals;
+    setup.supporting_signals.assign(signals.begin(), signals.end());
     setup.technical_confluence = static_cast<int>(signals.size());
     
     if (signals.empty()) return setup;
@@ -121,7 +210,7 @@ TradingSetup StrategyEngine::combineSignalsToSetup(const std::string& symbol,
     return setup;
 }
 
-double StrategyEngine::calculateSetupConfidence(const std::vector<TradingSignal>& signals) {
+double StrategyEngine::calculateSetupConfidence(Span<const TradingSignal> signals) {
     if (signals.empty()) return 0.0;
     
     double sum = 0.0;
@@ -142,7 +231,7 @@ bool StrategyEngine::isHighQualitySetup(const TradingSetup& setup) {
 }
 
 void StrategyEngine::updateSignalMetrics(TradingSignal& signal, const StockData& stock) {
-    signal.symbol = stock.symbol;
+    signal.symbol = stock.symbol_id;
     signal.volume_above_average = stock.volume_spike;
     signal.breakout_confirmed = stock.is_breakout || stock.is_breakdown;
     signal.technical_score = std::min(1.0, (stock.rsi_14 / 50.0) * 0.5 + 0.5);
@@ -157,42 +246,41 @@ std::vector<std::string> StrategyEngine::getActiveStrategies() const {
 }
 
 // ORB Strategy Implementation
-std::vector<TradingSignal> ORBStrategy::analyze(const StockData& stock, const HistoricalData& historical) {
-    std::vector<TradingSignal> signals;
-    
+void ORBStrategy::analyze(const StockData& stock, const HistoricalData& historical, SignalList& out) {
     auto orb_levels = calculateORBLevels(historical);
-    if (!orb_levels.is_valid) return signals;
+    if (!orb_levels.is_valid) return;
     
     TradingSignal signal;
     signal.strategy = StrategyType::ORB;
-    signal.symbol = stock.symbol;
+    signal.symbol = stock.symbol_id;
+    double range_pct = orb_levels.range_size.toDouble() / stock.current_price.toDouble() * 100.0;
     
     // Check for breakout above ORB high
     if (stock.current_price > orb_levels.orb_high) {
         signal.type = SignalType::BUY;
         signal.entry_price = orb_levels.orb_high;
         signal.stop_loss = orb_levels.orb_low;
-        signal.target_1 = orb_levels.orb_high + (orb_levels.range_size * 1.5);
+        signal.target_1 = PriceUtils::roundToTick(
+            orb_levels.orb_high + Price::fromRupees(orb_levels.range_size.toDouble() * 1.5));
         signal.confidence = calculateBreakoutProbability(stock, orb_levels);
-        signal.setup_description = "ORB Breakout - Price above opening range high";
-        signals.push_back(signal);
+        signal.setReason(SignalReason::ORB_BREAKOUT, range_pct);
+        out.push_back(signal);
     }
     // Check for breakdown below ORB low
     else if (stock.current_price < orb_levels.orb_low) {
         signal.type = SignalType::SELL;
         signal.entry_price = orb_levels.orb_low;
         signal.stop_loss = orb_levels.orb_high;
-        signal.target_1 = orb_levels.orb_low - (orb_levels.range_size * 1.5);
+        signal.target_1 = PriceUtils::roundToTick(
+            orb_levels.orb_low - Price::fromRupees(orb_levels.range_size.toDouble() * 1.5));
         signal.confidence = calculateBreakoutProbability(stock, orb_levels);
-        signal.setup_description = "ORB Breakdown - Price below opening range low";
-        signals.push_back(signal);
+        signal.setReason(SignalReason::ORB_BREAKDOWN, range_pct);
+        out.push_back(signal);
     }
-    
-    return signals;
 }
 
 bool ORBStrategy::isApplicable(const StockData& stock) const {
-    return stock.volume_ratio > 1.2 && stock.current_price > 100; // Minimum criteria
+    return stock.volume_ratio > 1.2 && stock.current_price > Price::fromPaise(100 * 100); // Minimum criteria
 }
 
 ORBStrategy::ORBLevels ORBStrategy::calculateORBLevels(const HistoricalData& historical, int minutes) {
@@ -202,7 +290,7 @@ ORBStrategy::ORBLevels ORBStrategy::calculateORBLevels(const HistoricalData& his
     if (historical.candles.size() < 5) return levels;
     
     // Use first few candles as opening range
-    double high = 0, low = std::numeric_limits<double>::max();
+    Price high = historical.candles[0].high, low = historical.candles[0].low;
     for (size_t i = 0; i < std::min(size_t(5), historical.candles.size()); ++i) {
         high = std::max(high, historical.candles[i].high);
         low = std::min(low, historical.candles[i].low);
@@ -211,7 +299,7 @@ ORBStrategy::ORBLevels ORBStrategy::calculateORBLevels(const HistoricalData& his
     levels.orb_high = high;
     levels.orb_low = low;
     levels.range_size = high - low;
-    levels.is_valid = levels.range_size > 0;
+    levels.is_valid = levels.range_size.isPositive();
     
     return levels;
 }
@@ -223,46 +311,52 @@ double ORBStrategy::calculateBreakoutProbability(const StockData& stock, const O
     if (stock.volume_ratio > 1.5) base_prob += 0.2;
     
     // Range size factor
-    double range_pct = levels.range_size / stock.current_price;
+    double range_pct = levels.range_size.toDouble() / stock.current_price.toDouble();
     if (range_pct > 0.02) base_prob += 0.1;
     
     return std::min(0.9, base_prob);
 }
 
 // VWAP Strategy Implementation
-std::vector<TradingSignal> VWAPStrategy::analyze(const StockData& stock, const HistoricalData& historical) {
+void VWAPStrategy::analyze(const StockData& stock, const HistoricalData& historical, SignalList& out) {
     (void)historical; // Suppress unused parameter warning
-    std::vector<TradingSignal> signals;
     
-    if (stock.vwap <= 0) return signals;
+    if (stock.vwap <= 0) return;
     
     TradingSignal signal;
     signal.strategy = StrategyType::VWAP;
-    signal.symbol = stock.symbol;
+    signal.symbol = stock.symbol_id;
     
-    double price_diff_pct = (stock.current_price - stock.vwap) / stock.vwap;
+    double price = stock.current_price.toDouble();
+    double price_diff_pct = (price - stock.vwap) / stock.vwap;
     
-    if (price_diff_pct > 0.01 && stock.volume_ratio > 1.3) {
-        // Price above VWAP with volume
+    // Trigger beyond the session's 1-sigma band; 1% until the session has a spread
+    auto bands = VWAPBands(stock.vwap, stock.vwap_std_dev);
+    double trigger = stock.vwap_std_dev > 0 ? stock.vwap_std_dev : stock.vwap * 0.01;
+    
+    if (price - stock.vwap > trigger && stock.volume_ratio > 1.3) {
+        // Price above VWAP with volume; aim for the 2-sigma band while it is ahead
         signal.type = SignalType::BUY;
         signal.entry_price = stock.current_price;
-        signal.stop_loss = stock.vwap;
-        signal.target_1 = stock.current_price * 1.02;
+        signal.stop_loss = PriceUtils::floorToTick(Price::fromRupees(stock.vwap));
+        signal.target_1 = (stock.vwap_std_dev > 0 && price < bands.upper_2)
+                              ? PriceUtils::floorToTick(Price::fromRupees(bands.upper_2))
+                              : PriceUtils::scaleToTick(stock.current_price, 1.02);
         signal.confidence = calculateVWAPStrength(stock);
-        signal.setup_description = "VWAP Breakout - Price above VWAP with volume";
-        signals.push_back(signal);
-    } else if (price_diff_pct < -0.01 && stock.volume_ratio > 1.3) {
+        signal.setReason(SignalReason::VWAP_BREAKOUT, price_diff_pct * 100.0, stock.volume_ratio);
+        out.push_back(signal);
+    } else if (stock.vwap - price > trigger && stock.volume_ratio > 1.3) {
         // Price below VWAP with volume
         signal.type = SignalType::SELL;
         signal.entry_price = stock.current_price;
-        signal.stop_loss = stock.vwap;
-        signal.target_1 = stock.current_price * 0.98;
+        signal.stop_loss = PriceUtils::ceilToTick(Price::fromRupees(stock.vwap));
+        signal.target_1 = (stock.vwap_std_dev > 0 && price > bands.lower_2)
+                              ? PriceUtils::ceilToTick(Price::fromRupees(bands.lower_2))
+                              : PriceUtils::scaleToTick(stock.current_price, 0.98);
         signal.confidence = calculateVWAPStrength(stock);
-        signal.setup_description = "VWAP Breakdown - Price below VWAP with volume";
-        signals.push_back(signal);
+        signal.setReason(SignalReason::VWAP_BREAKDOWN, price_diff_pct * 100.0, stock.volume_ratio);
+        out.push_back(signal);
     }
-    
-    return signals;
 }
 
 bool VWAPStrategy::isApplicable(const StockData& stock) const {
@@ -275,35 +369,41 @@ double VWAPStrategy::calculateVWAPStrength(const StockData& stock) {
     // Volume factor
     if (stock.volume_ratio > 1.5) base_strength += 0.2;
     
-    // Price distance from VWAP
-    double distance = std::abs(stock.current_price - stock.vwap) / stock.vwap;
-    if (distance > 0.01) base_strength += 0.1;
+    // Price distance from VWAP: between the 1 and 2 sigma bands the move
+    // still has room; past 2 sigma it is stretched
+    double distance = std::abs(stock.current_price.toDouble() - stock.vwap);
+    if (stock.vwap_std_dev > 0) {
+        if (distance < 2.0 * stock.vwap_std_dev) base_strength += 0.1;
+    } else if (distance / stock.vwap > 0.01) {
+        base_strength += 0.1;
+    }
     
     return std::min(0.8, base_strength);
 }
 
 // RSI Strategy Implementation (stub)
-std::vector<TradingSignal> RSIStrategy::analyze(const StockData& stock, const HistoricalData& historical) {
+void RSIStrategy::analyze(const StockData& stock, const HistoricalData& historical, SignalList& out) {
     (void)historical;
-    std::vector<TradingSignal> signals;
     
     TradingSignal signal;
     signal.strategy = StrategyType::RSI;
-    signal.symbol = stock.symbol;
+    signal.symbol = stock.symbol_id;
     
+    // A reversal candle on the last completed bar confirms the extreme,
+    // as does the 15m RSI being stretched the same way
     if (isOversold(stock.rsi_14)) {
         signal.type = SignalType::BUY;
-        signal.confidence = 0.6;
-        signal.setup_description = "RSI Oversold";
-        signals.push_back(signal);
+        signal.confidence = (stock.candle_patterns & CandlePattern::BULLISH_REVERSAL) ? 0.7 : 0.6;
+        if (isOversold(stock.rsi_14_15m)) signal.confidence += 0.05;
+        signal.setReason(SignalReason::RSI_OVERSOLD, stock.rsi_14);
+        out.push_back(signal);
     } else if (isOverbought(stock.rsi_14)) {
         signal.type = SignalType::SELL;
-        signal.confidence = 0.6;
-        signal.setup_description = "RSI Overbought";
-        signals.push_back(signal);
+        signal.confidence = (stock.candle_patterns & CandlePattern::BEARISH_REVERSAL) ? 0.7 : 0.6;
+        if (isOverbought(stock.rsi_14_15m)) signal.confidence += 0.05;
+        signal.setReason(SignalReason::RSI_OVERBOUGHT, stock.rsi_14);
+        out.push_back(signal);
     }
-    
-    return signals;
 }
 
 bool RSIStrategy::isApplicable(const StockData& stock) const {
@@ -324,20 +424,16 @@ double RSIStrategy::calculateDivergenceStrength(const HistoricalData& historical
 }
 
 // Breakout Strategy Implementation (stub)
-std::vector<TradingSignal> BreakoutStrategy::analyze(const StockData& stock, const HistoricalData& historical) {
-    std::vector<TradingSignal> signals;
-    
+void BreakoutStrategy::analyze(const StockData& stock, const HistoricalData& historical, SignalList& out) {
     if (detectBreakout(stock, historical)) {
         TradingSignal signal;
         signal.strategy = StrategyType::BREAKOUT;
-        signal.symbol = stock.symbol;
+        signal.symbol = stock.symbol_id;
         signal.type = SignalType::BUY;
-        signal.confidence = 0.7;
-        signal.setup_description = "Price Breakout";
-        signals.push_back(signal);
+        signal.confidence = calculateBreakoutStrength(stock, historical);
+        signal.setReason(SignalReason::PRICE_BREAKOUT, stock.volume_ratio);
+        out.push_back(signal);
     }
-    
-    return signals;
 }
 
 bool BreakoutStrategy::isApplicable(const StockData& stock) const {
@@ -355,27 +451,31 @@ bool BreakoutStrategy::detectBreakdown(const StockData& stock, const HistoricalD
 }
 
 double BreakoutStrategy::calculateBreakoutStrength(const StockData& stock, const HistoricalData& historical) {
-    (void)stock;
     (void)historical;
-    return 0.7; // Stub
+    double strength = 0.6;
+    
+    // Momentum confirmation: MACD above its signal line
+    if (stock.macd_histogram > 0) strength += 0.1;
+    
+    // Volume confirmation
+    if (stock.volume_ratio > 1.5) strength += 0.1;
+    
+    return std::min(0.85, strength);
 }
 
 // Volume Strategy Implementation (stub)
-std::vector<TradingSignal> VolumeStrategy::analyze(const StockData& stock, const HistoricalData& historical) {
+void VolumeStrategy::analyze(const StockData& stock, const HistoricalData& historical, SignalList& out) {
     (void)historical;
-    std::vector<TradingSignal> signals;
     
     if (isVolumeSpike(stock) && isPriceVolumeAlignment(stock)) {
         TradingSignal signal;
         signal.strategy = StrategyType::VOLUME_SPIKE;
-        signal.symbol = stock.symbol;
-        signal.type = stock.change > 0 ? SignalType::BUY : SignalType::SELL;
+        signal.symbol = stock.symbol_id;
+        signal.type = stock.change.isPositive() ? SignalType::BUY : SignalType::SELL;
         signal.confidence = calculateVolumeStrength(stock);
-        signal.setup_description = "Volume Spike with Price Alignment";
-        signals.push_back(signal);
+        signal.setReason(SignalReason::VOLUME_SPIKE, stock.volume_ratio, stock.change_percent);
+        out.push_back(signal);
     }
-    
-    return signals;
 }
 
 bool VolumeStrategy::isApplicable(const StockData& stock) const {
@@ -387,14 +487,76 @@ bool VolumeStrategy::isVolumeSpike(const StockData& stock, double threshold) {
 }
 
 bool VolumeStrategy::isPriceVolumeAlignment(const StockData& stock) {
-    return (stock.change > 0 && stock.volume_spike) || 
-           (stock.change < 0 && stock.volume_spike);
+    return (stock.change > Price() && stock.volume_spike) || 
+           (stock.change < Price() && stock.volume_spike);
 }
 
 double VolumeStrategy::calculateVolumeStrength(const StockData& stock) {
     return std::min(0.8, stock.volume_ratio * 0.3);
 }
 
+// Pairs Strategy Implementation
+void PairsStrategy::analyze(const PairStats& pair, const StockData& a, const StockData& b,
+                            SignalList& out) const {
+    if (pair.hedge_ratio <= 0 || pair.spread_sigma <= 0) return;
+    if (!a.current_price.isPositive() || !b.current_price.isPositive()) return;
+    
+    // The scanner's z is at the last completed bar; trade on where the spread is now
+    double sigma = pair.spread_sigma;
+    double z = (std::log(a.current_price.toDouble()) - pair.intercept -
+                pair.hedge_ratio * std::log(b.current_price.toDouble())) / sigma;
+    if (std::abs(z) < entry_z_) return;
+    
+    double confidence = calculatePairConfidence(pair, z);
+    if (confidence < getMinConfidenceThreshold()) return;
+    
+    // Spread low: a is cheap against b, so buy a and sell b
+    bool spread_low = z < 0;
+    double stop = spread_low ? -stop_z_ : stop_z_;
+    SignalReason reason = spread_low ? SignalReason::PAIR_SPREAD_LOW : SignalReason::PAIR_SPREAD_HIGH;
+    
+    // Taking the spread from z to z' moves a by exp((z' - z) * sigma), or b by
+    // exp((z - z') * sigma / hedge)
+    auto moved = [](Price price, double log_change) {
+        return PriceUtils::roundToTick(Price::fromRupees(price.toDouble() * std::exp(log_change)));
+    };
+    
+    TradingSignal leg_a;
+    leg_a.strategy = StrategyType::PAIRS;
+    leg_a.symbol = a.symbol_id;
+    leg_a.type = spread_low ? SignalType::BUY : SignalType::SELL;
+    leg_a.entry_price = a.current_price;
+    leg_a.target_1 = moved(a.current_price, -z * sigma);
+    leg_a.stop_loss = moved(a.current_price, (stop - z) * sigma);
+    leg_a.confidence = confidence;
+    leg_a.setReason(reason, z, pair.hedge_ratio);
+    
+    TradingSignal leg_b = leg_a;
+    leg_b.symbol = b.symbol_id;
+    leg_b.type = spread_low ? SignalType::SELL : SignalType::BUY;
+    leg_b.entry_price = b.current_price;
+    leg_b.target_1 = moved(b.current_price, z * sigma / pair.hedge_ratio);
+    leg_b.stop_loss = moved(b.current_price, (z - stop) * sigma / pair.hedge_ratio);
+    
+    out.push_back(leg_a);
+    out.push_back(leg_b);
+}
+
+double PairsStrategy::calculatePairConfidence(const PairStats& pair, double z_score) const {
+    double confidence = 0.6;
+    
+    // Unit root rejected at 1%, not just 5%
+    if (pair.adf_t < PairsScanner::CRITICAL_T_1) confidence += 0.1;
+    
+    // Further out is more room to revert, up to the stop
+    confidence += std::min(0.1, (std::abs(z_score) - entry_z_) * 0.1);
+    
+    // Reverts within a quarter hour
+    if (pair.half_life > 0 && pair.half_life <= 15) confidence += 0.05;
+    
+    return std::min(0.85, confidence);
+}
+
 // Additional StrategyEngine methods (stubs)
 void StrategyEngine::removeStrategy(const std::string& name) {
     strategies_.erase(
@@ -462,10 +624,75 @@ void StrategyEngine::setMaxSignalsPerStock(int max_signals) {
     max_signals_per_stock_ = max_signals;
 }
 
+void StrategyEngine::setMaxCorrelation(double limit) {
+    max_correlation_ = limit;
+}
+
+void StrategyEngine::filterCorrelatedSetups(std::vector<TradingSetup>& setups,
+                                            const CorrelationMatrix& correlations) const {
+    if (!correlations.ready()) return;
+    
+    auto direction = [](SignalType type) {
+        if (type == SignalType::BUY || type == SignalType::STRONG_BUY) return 1;
+        if (type == SignalType::SELL || type == SignalType::STRONG_SELL) return -1;
+        return 0;
+    };
+    
+    // A setup's exposure as signed legs: one for a directional setup; a pair
+    // is long one name and short hedge_ratio (reason_params[1]) of the other
+    struct Leg {
+        SymbolId symbol;
+        double weight;
+    };
+    auto addLegs = [&direction](const TradingSetup& setup, std::vector<Leg>& legs) {
+        const auto& signals = setup.supporting_signals;
+        if (!signals.empty() && signals[0].strategy == StrategyType::PAIRS) {
+            for (size_t i = 0; i < signals.size(); ++i) {
+                double size = i == 0 ? 1.0 : signals[i].reason_params[1];
+                legs.push_back({signals[i].symbol, direction(signals[i].type) * size});
+            }
+        } else {
+            legs.push_back({SymbolTable::find(setup.symbol), static_cast<double>(direction(setup.primary_signal))});
+        }
+    };
+    
+    // Longs in correlated names (or a long and a short in inversely
+    // correlated ones) are the same bet; keep the better-ranked one. Legs
+    // are netted, so a hedged pair only clashes through what it leaves open.
+    std::vector<Leg> kept;
+    std::vector<size_t> kept_start;   // first leg of each kept setup
+    std::vector<Leg> candidate;
+    size_t write = 0;
+    for (size_t read = 0; read < setups.size(); ++read) {
+        candidate.clear();
+        addLegs(setups[read], candidate);
+        
+        bool concentrated = false;
+        for (size_t k = 0; k < kept_start.size() && !concentrated; ++k) {
+            size_t end = k + 1 < kept_start.size() ? kept_start[k + 1] : kept.size();
+            double shared = 0.0;
+            for (const auto& leg : candidate) {
+                for (size_t i = kept_start[k]; i < end; ++i) {
+                    shared += leg.weight * kept[i].weight * correlations.correlation(leg.symbol, kept[i].symbol);
+                }
+            }
+            concentrated = shared > max_correlation_;
+        }
+        if (concentrated) continue;
+        
+        kept_start.push_back(kept.size());
+        kept.insert(kept.end(), candidate.begin(), candidate.end());
+        if (write != read) setups[write] = std::move(setups[read]);
+        ++write;
+    }
+    setups.erase(setups.begin() + write, setups.end());
+}
+
 std::vector<std::string> StrategyEngine::getAvailableStrategies() const {
     std::vector<std::string> available;
     for (const auto& strategy : strategies_) {
         available.push_back(strategy->getName());
     }
+    available.push_back(pairs_strategy_.getName());
     return available;
 }
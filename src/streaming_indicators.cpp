@@ -0,0 +1,804 @@
+#include "streaming_indicators.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    bool sameBar(const OHLCV& a, const OHLCV& b) {
+        return a.timestamp == b.timestamp && a.close == b.close && a.high == b.high &&
+               a.low == b.low && a.open == b.open && a.volume == b.volume;
+    }
+
+    // `offset` past 00:00 UTC on the day of `time`, so pre-open bars fall before it
+    std::chrono::system_clock::time_point sessionStart(std::chrono::system_clock::time_point time,
+                                                       std::chrono::minutes offset) {
+        using Days = std::chrono::duration<std::int64_t, std::ratio<86400>>;
+        auto day = std::chrono::floor<Days>(time.time_since_epoch());
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(day + offset));
+    }
+}
+
+// StreamingSMA
+StreamingSMA::StreamingSMA(int periods) : closes_(periods), periods_(periods), sum_(0) {
+}
+
+void StreamingSMA::push(const OHLCV& bar) {
+    if (closes_.full()) sum_ -= closes_.front();
+    closes_.push(bar.close.paise);
+    sum_ += bar.close.paise;
+}
+
+void StreamingSMA::amendLast(const OHLCV& bar) {
+    if (closes_.empty()) {
+        push(bar);
+        return;
+    }
+    sum_ += static_cast<std::int64_t>(bar.close.paise) - closes_.back();
+    closes_.replaceLast(bar.close.paise);
+}
+
+double StreamingSMA::value() const {
+    if (!ready()) return 0.0;
+    return static_cast<double>(sum_) / periods_ / 100.0;
+}
+
+// StreamingEMA
+StreamingEMA::StreamingEMA(int periods) : periods_(periods), alpha_(2.0 / (periods + 1)) {
+}
+
+void StreamingEMA::push(const OHLCV& bar) {
+    before_last_ = state_;
+    apply(state_, bar.close);
+}
+
+void StreamingEMA::amendLast(const OHLCV& bar) {
+    state_ = before_last_;
+    apply(state_, bar.close);
+}
+
+void StreamingEMA::apply(State& state, Price close) const {
+    if (state.count < periods_) {
+        state.seed_sum += close.paise;
+        if (++state.count == periods_) {
+            state.ema = static_cast<double>(state.seed_sum) / periods_ / 100.0;
+        }
+        return;
+    }
+    state.ema = close.toDouble() * alpha_ + state.ema * (1 - alpha_);
+}
+
+// StreamingRSI
+StreamingRSI::StreamingRSI(int periods) : periods_(periods) {
+}
+
+void StreamingRSI::push(const OHLCV& bar) {
+    before_last_ = state_;
+    apply(state_, bar.close);
+}
+
+void StreamingRSI::amendLast(const OHLCV& bar) {
+    state_ = before_last_;
+    apply(state_, bar.close);
+}
+
+void StreamingRSI::apply(State& state, Price close) const {
+    if (!state.has_prev) {
+        state.prev_close = close;
+        state.has_prev = true;
+        return;
+    }
+
+    double change = (close - state.prev_close).toDouble();
+    double gain = change > 0 ? change : 0;
+    double loss = change < 0 ? -change : 0;
+    state.prev_close = close;
+
+    if (state.changes < periods_) {
+        // Seed with the plain average of the first `periods` changes
+        state.avg_gain += gain;
+        state.avg_loss += loss;
+        if (++state.changes == periods_) {
+            state.avg_gain /= periods_;
+            state.avg_loss /= periods_;
+        }
+        return;
+    }
+
+    state.avg_gain = ((state.avg_gain * (periods_ - 1)) + gain) / periods_;
+    state.avg_loss = ((state.avg_loss * (periods_ - 1)) + loss) / periods_;
+}
+
+double StreamingRSI::value() const {
+    if (!ready()) return 50.0;
+    if (state_.avg_loss == 0) return 100.0;
+
+    double rs = state_.avg_gain / state_.avg_loss;
+    return 100.0 - (100.0 / (1.0 + rs));
+}
+
+// StreamingATR
+StreamingATR::StreamingATR(int periods) : periods_(periods) {
+}
+
+void StreamingATR::push(const OHLCV& bar) {
+    before_last_ = state_;
+    apply(state_, bar);
+}
+
+void StreamingATR::amendLast(const OHLCV& bar) {
+    state_ = before_last_;
+    apply(state_, bar);
+}
+
+void StreamingATR::apply(State& state, const OHLCV& bar) const {
+    if (!state.has_prev) {
+        state.prev = bar;
+        state.has_prev = true;
+        return;
+    }
+
+    double true_range = TechnicalIndicators::calculateTrueRange(bar, state.prev);
+    state.prev = bar;
+
+    if (state.ranges < periods_) {
+        state.atr += true_range;
+        if (++state.ranges == periods_) {
+            state.atr /= periods_;
+        }
+        return;
+    }
+
+    state.atr = ((state.atr * (periods_ - 1)) + true_range) / periods_;
+}
+
+// StreamingBollinger
+StreamingBollinger::StreamingBollinger(int periods, double multiplier)
+    : closes_(periods), periods_(periods), multiplier_(multiplier), sum_(0), sum_sq_(0) {
+}
+
+void StreamingBollinger::push(const OHLCV& bar) {
+    if (closes_.full()) {
+        std::int64_t oldest = closes_.front();
+        sum_ -= oldest;
+        sum_sq_ -= oldest * oldest;
+    }
+    std::int64_t close = bar.close.paise;
+    closes_.push(bar.close.paise);
+    sum_ += close;
+    sum_sq_ += close * close;
+}
+
+void StreamingBollinger::amendLast(const OHLCV& bar) {
+    if (closes_.empty()) {
+        push(bar);
+        return;
+    }
+    std::int64_t previous = closes_.back();
+    std::int64_t close = bar.close.paise;
+    sum_ += close - previous;
+    sum_sq_ += close * close - previous * previous;
+    closes_.replaceLast(bar.close.paise);
+}
+
+BollingerBands StreamingBollinger::value() const {
+    if (!ready()) return BollingerBands();
+
+    // Sums are exact integers, so the one-pass variance doesn't accumulate error
+    double mean = static_cast<double>(sum_) / periods_;
+    double variance = static_cast<double>(sum_sq_) / periods_ - mean * mean;
+    double std_dev = std::sqrt(std::max(0.0, variance)) / 100.0;
+    double middle = mean / 100.0;
+
+    return BollingerBands(
+        middle + (multiplier_ * std_dev),
+        middle,
+        middle - (multiplier_ * std_dev)
+    );
+}
+
+// StreamingVWAP
+StreamingVWAP::StreamingVWAP() {
+    reset();
+}
+
+void StreamingVWAP::push(const OHLCV& bar) {
+    last_price_volume_ = TechnicalIndicators::calculateTypicalPrice(bar) * bar.volume;
+    last_volume_ = bar.volume;
+    price_volume_ += last_price_volume_;
+    volume_ += last_volume_;
+}
+
+void StreamingVWAP::amendLast(const OHLCV& bar) {
+    price_volume_ -= last_price_volume_;
+    volume_ -= last_volume_;
+    push(bar);
+}
+
+void StreamingVWAP::reset() {
+    price_volume_ = 0.0;
+    volume_ = 0;
+    last_price_volume_ = 0.0;
+    last_volume_ = 0;
+}
+
+// AnchoredVWAP
+AnchoredVWAP::AnchoredVWAP(std::chrono::minutes daily_anchor)
+    : daily_anchor_(daily_anchor), fixed_anchor_(false), anchored_(false) {
+    restart(anchor_);
+}
+
+void AnchoredVWAP::anchorAt(std::chrono::system_clock::time_point anchor) {
+    fixed_anchor_ = true;
+    anchored_ = true;
+    restart(anchor);
+}
+
+void AnchoredVWAP::restart(std::chrono::system_clock::time_point anchor) {
+    anchor_ = anchor;
+    price_volume_ = 0.0;
+    price_sq_volume_ = 0.0;
+    volume_ = 0;
+    has_last_ = false;
+    last_price_volume_ = 0.0;
+    last_price_sq_volume_ = 0.0;
+    last_volume_ = 0;
+}
+
+std::chrono::system_clock::time_point AnchoredVWAP::sessionAnchor(std::chrono::system_clock::time_point time) const {
+    return sessionStart(time, daily_anchor_);
+}
+
+void AnchoredVWAP::push(const OHLCV& bar) {
+    if (!fixed_anchor_) {
+        auto anchor = sessionAnchor(bar.timestamp);
+        if (!anchored_ || anchor > anchor_) {
+            restart(anchor);
+            anchored_ = true;
+        }
+    }
+    if (bar.timestamp < anchor_) {
+        has_last_ = false;
+        return;
+    }
+
+    double typical_price = TechnicalIndicators::calculateTypicalPrice(bar);
+    last_price_volume_ = typical_price * bar.volume;
+    last_price_sq_volume_ = typical_price * typical_price * bar.volume;
+    last_volume_ = bar.volume;
+    has_last_ = true;
+
+    price_volume_ += last_price_volume_;
+    price_sq_volume_ += last_price_sq_volume_;
+    volume_ += last_volume_;
+}
+
+void AnchoredVWAP::amendLast(const OHLCV& bar) {
+    if (has_last_) {
+        price_volume_ -= last_price_volume_;
+        price_sq_volume_ -= last_price_sq_volume_;
+        volume_ -= last_volume_;
+    }
+    push(bar);
+}
+
+double AnchoredVWAP::standardDeviation() const {
+    if (volume_ <= 0) return 0.0;
+
+    double vwap = value();
+    double variance = price_sq_volume_ / volume_ - vwap * vwap;
+    return std::sqrt(std::max(0.0, variance));
+}
+
+VWAPBands AnchoredVWAP::bands() const {
+    if (volume_ <= 0) return VWAPBands();
+    return VWAPBands(value(), standardDeviation());
+}
+
+// VolumeProfile
+VolumeProfile::VolumeProfile(int bucket_bps, double value_area, std::chrono::minutes daily_anchor)
+    : bucket_bps_(std::max(bucket_bps, 1)), value_area_(value_area), daily_anchor_(daily_anchor),
+      anchored_(false) {
+    restart(anchor_);
+}
+
+void VolumeProfile::push(const OHLCV& bar) {
+    auto anchor = sessionStart(bar.timestamp, daily_anchor_);
+    if (!anchored_ || anchor > anchor_) {
+        restart(anchor);
+        anchored_ = true;
+    }
+    if (bar.timestamp < anchor_) {
+        has_last_ = false;
+        return;
+    }
+
+    add(bar);
+    last_ = bar;
+    has_last_ = true;
+}
+
+void VolumeProfile::amendLast(const OHLCV& bar) {
+    if (has_last_) remove(last_);
+    push(bar);
+}
+
+const VolumeProfileLevels& VolumeProfile::levels() const {
+    if (levels_stale_) {
+        levels_ = TechnicalIndicators::volumeProfileLevels(volumes_, first_bucket_, poc_bucket_, volume_,
+                                                           bucketSize(), value_area_);
+        levels_stale_ = false;
+    }
+    return levels_;
+}
+
+void VolumeProfile::restart(std::chrono::system_clock::time_point anchor) {
+    anchor_ = anchor;
+    bucket_paise_ = 0;
+    first_bucket_ = 0;
+    volumes_.clear();   // capacity kept for the next session
+    volume_ = 0;
+    poc_bucket_ = 0;
+    has_last_ = false;
+    levels_stale_ = true;
+}
+
+void VolumeProfile::add(const OHLCV& bar) {
+    if (bucket_paise_ == 0) {
+        std::int32_t tick = PriceUtils::tickSizeFor(bar.close).paise;
+        std::int64_t width = static_cast<std::int64_t>(bar.close.paise) * bucket_bps_ / 10000;
+        bucket_paise_ = std::max(tick, static_cast<std::int32_t>(width / tick * tick));
+    }
+    std::int32_t low = bar.low.paise / bucket_paise_;
+    std::int32_t high = bar.high.paise / bucket_paise_;
+    if (high < low) return;
+
+    if (volumes_.empty()) poc_bucket_ = low;
+    coverBuckets(low, high);
+
+    Quantity buckets = high - low + 1;
+    std::int32_t at_close = std::max(low, std::min(high, bar.close.paise / bucket_paise_));
+    for (std::int32_t bucket = low; bucket <= high; ++bucket) {
+        Quantity& volume = volumes_[bucket - first_bucket_];
+        volume += bar.volume / buckets + (bucket == at_close ? bar.volume % buckets : 0);
+
+        // Only these buckets grew, so the POC can only move to one of them
+        Quantity poc_volume = volumes_[poc_bucket_ - first_bucket_];
+        if (volume > poc_volume || (volume == poc_volume && bucket < poc_bucket_)) {
+            poc_bucket_ = bucket;
+        }
+    }
+    volume_ += bar.volume;
+    levels_stale_ = true;
+}
+
+void VolumeProfile::remove(const OHLCV& bar) {
+    std::int32_t low = bar.low.paise / bucket_paise_;
+    std::int32_t high = bar.high.paise / bucket_paise_;
+    if (high < low) return;
+
+    Quantity buckets = high - low + 1;
+    std::int32_t at_close = std::max(low, std::min(high, bar.close.paise / bucket_paise_));
+    for (std::int32_t bucket = low; bucket <= high; ++bucket) {
+        volumes_[bucket - first_bucket_] -= bar.volume / buckets + (bucket == at_close ? bar.volume % buckets : 0);
+    }
+    volume_ -= bar.volume;
+    levels_stale_ = true;
+
+    if (poc_bucket_ >= low && poc_bucket_ <= high && bar.volume > 0) {
+        auto heaviest = std::max_element(volumes_.begin(), volumes_.end());
+        poc_bucket_ = first_bucket_ + static_cast<std::int32_t>(heaviest - volumes_.begin());
+    }
+}
+
+void VolumeProfile::coverBuckets(std::int32_t low, std::int32_t high) {
+    if (volumes_.empty()) {
+        first_bucket_ = low;
+        volumes_.assign(static_cast<size_t>(high - low) + 1, 0);
+        return;
+    }
+
+    // Grow by at least the current size, so a trending session reallocates rarely
+    if (low < first_bucket_) {
+        size_t grow = std::max(static_cast<size_t>(first_bucket_ - low), volumes_.size());
+        volumes_.insert(volumes_.begin(), grow, 0);
+        first_bucket_ -= static_cast<std::int32_t>(grow);
+    }
+    size_t needed = static_cast<size_t>(high - first_bucket_) + 1;
+    if (needed > volumes_.size()) {
+        volumes_.resize(std::max(needed, volumes_.size() * 2), 0);
+    }
+}
+
+// StreamingMACD
+StreamingMACD::StreamingMACD(int fast_periods, int slow_periods, int signal_periods)
+    : fast_(fast_periods), slow_(slow_periods), signal_periods_(signal_periods),
+      alpha_(2.0 / (signal_periods + 1)) {
+}
+
+void StreamingMACD::push(const OHLCV& bar) {
+    fast_.push(bar);
+    slow_.push(bar);
+    before_last_ = signal_;
+    applySignal(signal_);
+}
+
+void StreamingMACD::amendLast(const OHLCV& bar) {
+    fast_.amendLast(bar);
+    slow_.amendLast(bar);
+    signal_ = before_last_;
+    applySignal(signal_);
+}
+
+void StreamingMACD::applySignal(SignalState& state) const {
+    if (!slow_.ready()) return;
+
+    double macd_line = fast_.value() - slow_.value();
+    if (state.count < signal_periods_) {
+        state.seed_sum += macd_line;
+        if (++state.count == signal_periods_) {
+            state.ema = state.seed_sum / signal_periods_;
+        }
+        return;
+    }
+    state.ema = macd_line * alpha_ + state.ema * (1 - alpha_);
+}
+
+MACD StreamingMACD::value() const {
+    if (!slow_.ready()) return MACD();
+
+    double macd_line = fast_.value() - slow_.value();
+    if (!ready()) return MACD(macd_line, macd_line, 0.0);
+    return MACD(macd_line, signal_.ema, macd_line - signal_.ema);
+}
+
+// StreamingDonchian
+StreamingDonchian::StreamingDonchian(int periods) : lows_(periods), highs_(periods) {
+}
+
+void StreamingDonchian::push(const OHLCV& bar) {
+    lows_.push(bar.low);
+    highs_.push(bar.high);
+}
+
+void StreamingDonchian::amendLast(const OHLCV& bar) {
+    lows_.amendLast(bar.low);
+    highs_.amendLast(bar.high);
+}
+
+DonchianChannel StreamingDonchian::value() const {
+    if (!ready()) return DonchianChannel();
+    return DonchianChannel(highs_.value(), lows_.value());
+}
+
+// StreamingStochastic
+StreamingStochastic::StreamingStochastic(int k_periods, int d_periods)
+    : range_(k_periods), k_values_(d_periods), d_periods_(d_periods) {
+}
+
+void StreamingStochastic::push(const OHLCV& bar) {
+    range_.push(bar);
+    if (!range_.ready()) return;
+
+    auto range = range_.value();
+    k_values_.push(TechnicalIndicators::stochasticK(bar.close, range.lower, range.upper));
+}
+
+void StreamingStochastic::amendLast(const OHLCV& bar) {
+    range_.amendLast(bar);
+    if (!range_.ready()) return;
+
+    auto range = range_.value();
+    k_values_.replaceLast(TechnicalIndicators::stochasticK(bar.close, range.lower, range.upper));
+}
+
+StochasticOscillator StreamingStochastic::value() const {
+    if (!ready()) return StochasticOscillator();
+
+    double d = 50.0;
+    if (k_values_.full()) {
+        double sum = 0.0;
+        for (double k : k_values_.view()) sum += k;
+        d = sum / d_periods_;
+    }
+    return StochasticOscillator(k_values_.back(), d);
+}
+
+// StreamingWilliamsR
+StreamingWilliamsR::StreamingWilliamsR(int periods) : range_(periods) {
+}
+
+void StreamingWilliamsR::push(const OHLCV& bar) {
+    range_.push(bar);
+    last_close_ = bar.close;
+}
+
+void StreamingWilliamsR::amendLast(const OHLCV& bar) {
+    range_.amendLast(bar);
+    last_close_ = bar.close;
+}
+
+double StreamingWilliamsR::value() const {
+    if (!ready()) return -50.0;
+
+    auto range = range_.value();
+    return TechnicalIndicators::williamsR(last_close_, range.lower, range.upper);
+}
+
+// StreamingDMI
+StreamingDMI::StreamingDMI(int periods) : periods_(periods) {
+}
+
+void StreamingDMI::push(const OHLCV& bar) {
+    before_last_ = state_;
+    apply(state_, bar);
+}
+
+void StreamingDMI::amendLast(const OHLCV& bar) {
+    state_ = before_last_;
+    apply(state_, bar);
+}
+
+void StreamingDMI::apply(State& state, const OHLCV& bar) const {
+    if (!state.has_prev) {
+        state.prev = bar;
+        state.has_prev = true;
+        return;
+    }
+
+    double true_range = TechnicalIndicators::calculateTrueRange(bar, state.prev);
+    double plus_dm = TechnicalIndicators::plusDirectionalMove(bar, state.prev);
+    double minus_dm = TechnicalIndicators::minusDirectionalMove(bar, state.prev);
+    state.prev = bar;
+
+    if (state.changes < periods_) {
+        state.smoothed_tr += true_range;
+        state.smoothed_plus += plus_dm;
+        state.smoothed_minus += minus_dm;
+        if (++state.changes < periods_) return;
+    } else {
+        state.smoothed_tr = state.smoothed_tr - (state.smoothed_tr / periods_) + true_range;
+        state.smoothed_plus = state.smoothed_plus - (state.smoothed_plus / periods_) + plus_dm;
+        state.smoothed_minus = state.smoothed_minus - (state.smoothed_minus / periods_) + minus_dm;
+    }
+
+    state.plus_di = state.smoothed_tr > 0 ? 100.0 * state.smoothed_plus / state.smoothed_tr : 0.0;
+    state.minus_di = state.smoothed_tr > 0 ? 100.0 * state.smoothed_minus / state.smoothed_tr : 0.0;
+
+    double dx = TechnicalIndicators::directionalIndex(state.plus_di, state.minus_di);
+    if (state.dx_count < periods_) {
+        state.adx += dx;
+        if (++state.dx_count == periods_) state.adx /= periods_;
+    } else {
+        state.adx = ((state.adx * (periods_ - 1)) + dx) / periods_;
+    }
+}
+
+DirectionalMovement StreamingDMI::value() const {
+    if (state_.changes < periods_) return DirectionalMovement();
+    return DirectionalMovement(state_.plus_di, state_.minus_di, ready() ? state_.adx : 0.0);
+}
+
+// StreamingOBV
+void StreamingOBV::push(const OHLCV& bar) {
+    before_last_ = state_;
+    apply(state_, bar);
+}
+
+void StreamingOBV::amendLast(const OHLCV& bar) {
+    state_ = before_last_;
+    apply(state_, bar);
+}
+
+void StreamingOBV::apply(State& state, const OHLCV& bar) {
+    if (state.has_prev) {
+        if (bar.close > state.prev_close) {
+            state.obv += bar.volume;
+        } else if (bar.close < state.prev_close) {
+            state.obv -= bar.volume;
+        }
+    }
+    state.prev_close = bar.close;
+    state.has_prev = true;
+}
+
+// StreamingPivots
+void StreamingPivots::push(const OHLCV& bar) {
+    if (bar_count_ > 0) levels_ = TechnicalIndicators::calculatePivotLevels(session_);
+    session_ = bar;
+    ++bar_count_;
+}
+
+void StreamingPivots::amendLast(const OHLCV& bar) {
+    if (bar_count_ == 0) {
+        push(bar);
+        return;
+    }
+    session_ = bar;
+}
+
+// IndicatorState
+IndicatorState::IndicatorState()
+    : donchian_20(20), bar_count_(0) {
+}
+
+void IndicatorState::update(const OHLCV& bar) {
+    if (bar_count_ == 0 || bar.timestamp > last_timestamp_) {
+        sma_20.push(bar);
+        sma_50.push(bar);
+        ema_9.push(bar);
+        ema_21.push(bar);
+        rsi_14.push(bar);
+        atr_14.push(bar);
+        bollinger_20.push(bar);
+        macd.push(bar);
+        donchian_20.push(bar);
+        dmi_14.push(bar);
+        obv.push(bar);
+        pivots.push(bar);
+        last_timestamp_ = bar.timestamp;
+        ++bar_count_;
+    } else if (bar.timestamp == last_timestamp_) {
+        sma_20.amendLast(bar);
+        sma_50.amendLast(bar);
+        ema_9.amendLast(bar);
+        ema_21.amendLast(bar);
+        rsi_14.amendLast(bar);
+        atr_14.amendLast(bar);
+        bollinger_20.amendLast(bar);
+        macd.amendLast(bar);
+        donchian_20.amendLast(bar);
+        dmi_14.amendLast(bar);
+        obv.amendLast(bar);
+        pivots.amendLast(bar);
+    }
+    // Older bars were already absorbed
+}
+
+void IndicatorState::update(CandleSpan bars) {
+    for (const auto& bar : bars) {
+        update(bar);
+    }
+}
+
+size_t IndicatorState::memoryBytes() const {
+    // The FixedPeriod windows are inline, counted in sizeof(IndicatorState)
+    return donchian_20.memoryBytes();
+}
+
+void IndicatorState::apply(StockData& stock) const {
+    stock.rsi_14 = rsi_14.value();
+    stock.sma_20 = sma_20.value();
+    stock.sma_50 = sma_50.value();
+    stock.ema_9 = ema_9.value();
+    stock.ema_21 = ema_21.value();
+    stock.atr_14 = atr_14.value();
+
+    auto bb = bollinger_20.value();
+    stock.bollinger_upper = bb.upper;
+    stock.bollinger_lower = bb.lower;
+
+    auto macd_value = macd.value();
+    stock.macd_line = macd_value.macd_line;
+    stock.macd_signal = macd_value.signal_line;
+    stock.macd_histogram = macd_value.histogram;
+
+    stock.support_level = support();
+    stock.resistance_level = resistance();
+}
+
+// IndicatorEngine
+void IndicatorEngine::updateDaily(SymbolId symbol, CandleSpan bars) {
+    if (bars.empty()) return;
+
+    auto& state = stateFor(symbol);
+    // Same newest bar as last time: no bar closed or changed since
+    if (state.daily.barCount() > 0 && sameBar(bars.back(), state.daily_last_bar)) {
+        ++daily_cache_.hits;
+        return;
+    }
+
+    ++daily_cache_.misses;
+    state.daily.update(bars);
+    state.daily_last_bar = bars.back();
+}
+
+void IndicatorEngine::updateIntraday(SymbolId symbol, const OHLCV& bar) {
+    auto& session = stateFor(symbol).session;
+
+    // AnchoredVWAP restarts by itself on the first bar past the next 09:15 IST
+    if (bar.timestamp > session.last_bar.timestamp) {
+        session.vwap.push(bar);
+        session.profile.push(bar);
+    } else if (bar.timestamp == session.last_bar.timestamp && !sameBar(bar, session.last_bar)) {
+        session.vwap.amendLast(bar);
+        session.profile.amendLast(bar);
+    } else {
+        // Already absorbed (a repeated fetch returns the whole session)
+        return;
+    }
+    session.last_bar = bar;
+}
+
+void IndicatorEngine::updateTimeframe(SymbolId symbol, BarInterval interval, CandleSpan bars) {
+    if (interval == BarInterval::DAILY || bars.empty()) return;
+
+    auto& state = stateFor(symbol);
+    size_t slot = static_cast<size_t>(interval);
+    const OHLCV& last = state.intraday_last_bar[slot];
+    if (state.intraday[slot].barCount() > 0 && sameBar(bars.back(), last)) {
+        ++intraday_cache_.hits;
+        return;
+    }
+
+    // Feed from the last bar absorbed (amended if it changed) onwards
+    size_t first = bars.size();
+    if (state.intraday[slot].barCount() == 0) {
+        first = 0;
+    } else {
+        while (first > 0 && bars[first - 1].timestamp >= last.timestamp) --first;
+    }
+
+    ++intraday_cache_.misses;
+    state.intraday[slot].update(bars.last(bars.size() - first));
+    state.intraday_last_bar[slot] = bars.back();
+}
+
+void IndicatorEngine::apply(SymbolId symbol, StockData& stock) const {
+    if (symbol >= states_.size()) return;
+
+    const auto& state = states_[symbol];
+    // Match the old full-recompute behaviour: leave defaults until 20 bars are in
+    if (state.daily.barCount() >= 20) {
+        state.daily.apply(stock);
+    }
+    if (state.session.vwap.volume() > 0) {
+        stock.vwap = state.session.vwap.value();
+        stock.vwap_std_dev = state.session.vwap.standardDeviation();
+    }
+    if (state.session.profile.volume() > 0) {
+        const auto& levels = state.session.profile.levels();
+        stock.point_of_control = levels.point_of_control;
+        stock.value_area_low = levels.value_area_low;
+        stock.value_area_high = levels.value_area_high;
+    }
+    const auto& fifteen = state.intraday[static_cast<size_t>(BarInterval::FIFTEEN_MINUTES)];
+    if (fifteen.rsi_14.ready()) {
+        stock.rsi_14_15m = fifteen.rsi_14.value();
+    }
+}
+
+const IndicatorState* IndicatorEngine::daily(SymbolId symbol) const {
+    return symbol < states_.size() ? &states_[symbol].daily : nullptr;
+}
+
+const VolumeProfile* IndicatorEngine::volumeProfile(SymbolId symbol) const {
+    return symbol < states_.size() ? &states_[symbol].session.profile : nullptr;
+}
+
+const IndicatorState* IndicatorEngine::timeframe(SymbolId symbol, BarInterval interval) const {
+    if (symbol >= states_.size()) return nullptr;
+    if (interval == BarInterval::DAILY) return &states_[symbol].daily;
+    return &states_[symbol].intraday[static_cast<size_t>(interval)];
+}
+
+VWAPBands IndicatorEngine::sessionVWAP(SymbolId symbol) const {
+    return symbol < states_.size() ? states_[symbol].session.vwap.bands() : VWAPBands();
+}
+
+size_t IndicatorEngine::memoryBytes() const {
+    size_t total = states_.capacity() * sizeof(SymbolState);
+    for (const auto& state : states_) {
+        total += state.daily.memoryBytes() + state.session.profile.memoryBytes();
+        for (const auto& intraday : state.intraday) {
+            total += intraday.memoryBytes();
+        }
+    }
+    return total;
+}
+
+IndicatorEngine::SymbolState& IndicatorEngine::stateFor(SymbolId symbol) {
+    if (symbol >= states_.size()) {
+        states_.resize(static_cast<size_t>(symbol) + 1);
+    }
+    return states_[symbol];
+}
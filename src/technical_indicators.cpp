@@ -1,33 +1,151 @@
 #include "technical_indicators.h"
+#include "rolling_extrema.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <limits>
 
-double TechnicalIndicators::calculateSMA(const std::vector<OHLCV>& data, int periods) {
+namespace {
+    // EMA recurrence shared by the EMA and MACD series, seeded like calculateEMA
+    struct EmaSeriesState {
+        int periods;
+        double multiplier;
+        double seed_sum;
+        double ema;
+        size_t count;
+        
+        explicit EmaSeriesState(int p)
+            : periods(p), multiplier(2.0 / (p + 1)), seed_sum(0.0), ema(0.0), count(0) {}
+        
+        // Value for the prefix ending at `candle` (0 until `periods` closes are in)
+        double next(const OHLCV& candle) {
+            double close = candle.close.toDouble();
+            if (count < static_cast<size_t>(periods)) {
+                seed_sum += close;
+                if (++count < static_cast<size_t>(periods)) return 0.0;
+                ema = seed_sum / periods;
+                return ema;
+            }
+            ++count;
+            ema = (close * multiplier) + (ema * (1 - multiplier));
+            return ema;
+        }
+        
+        bool ready() const { return count >= static_cast<size_t>(periods); }
+    };
+    
+    // MACD as an EMA chain: fast and slow EMAs of closes, then a signal EMA of
+    // their difference seeded with the SMA of the first signal_periods values
+    struct MacdSeriesState {
+        EmaSeriesState fast;
+        EmaSeriesState slow;
+        int signal_periods;
+        double signal_multiplier;
+        double signal_seed_sum;
+        double signal;
+        size_t macd_count;
+        
+        MacdSeriesState(int fast_periods, int slow_periods, int signal_p)
+            : fast(fast_periods), slow(slow_periods), signal_periods(signal_p),
+              signal_multiplier(2.0 / (signal_p + 1)), signal_seed_sum(0.0), signal(0.0), macd_count(0) {}
+        
+        // Value for the prefix ending at `candle`. Until the signal line is
+        // warm it reads as the MACD line itself (zero histogram).
+        MACD next(const OHLCV& candle) {
+            double fast_ema = fast.next(candle);
+            double slow_ema = slow.next(candle);
+            if (!slow.ready()) return MACD();
+            
+            double macd_line = fast_ema - slow_ema;
+            if (macd_count < static_cast<size_t>(signal_periods)) {
+                signal_seed_sum += macd_line;
+                if (++macd_count < static_cast<size_t>(signal_periods)) return MACD(macd_line, macd_line, 0.0);
+                signal = signal_seed_sum / signal_periods;
+            } else {
+                signal = (macd_line * signal_multiplier) + (signal * (1 - signal_multiplier));
+            }
+            return MACD(macd_line, signal, macd_line - signal);
+        }
+    };
+    
+    // Wilder's DMI recurrence shared by calculateDMI and its series: running
+    // sums of TR, +DM and -DM seeded with the first `periods` moves, and ADX
+    // as the average of the first `periods` DX values, then Wilder smoothing
+    struct DmiSeriesState {
+        int periods;
+        double smoothed_tr;
+        double smoothed_plus;
+        double smoothed_minus;
+        double adx;
+        int dx_count;
+        size_t count;
+        OHLCV previous;
+        
+        explicit DmiSeriesState(int p)
+            : periods(p), smoothed_tr(0.0), smoothed_plus(0.0), smoothed_minus(0.0), adx(0.0),
+              dx_count(0), count(0) {}
+        
+        // Value for the prefix ending at `candle` (zeros until `periods` moves are in)
+        DirectionalMovement next(const OHLCV& candle) {
+            size_t i = count++;
+            OHLCV prev = previous;
+            previous = candle;
+            if (i == 0) return DirectionalMovement();
+            
+            double true_range = TechnicalIndicators::calculateTrueRange(candle, prev);
+            double plus_dm = TechnicalIndicators::plusDirectionalMove(candle, prev);
+            double minus_dm = TechnicalIndicators::minusDirectionalMove(candle, prev);
+            
+            if (i <= static_cast<size_t>(periods)) {
+                smoothed_tr += true_range;
+                smoothed_plus += plus_dm;
+                smoothed_minus += minus_dm;
+                if (i < static_cast<size_t>(periods)) return DirectionalMovement();
+            } else {
+                smoothed_tr = smoothed_tr - (smoothed_tr / periods) + true_range;
+                smoothed_plus = smoothed_plus - (smoothed_plus / periods) + plus_dm;
+                smoothed_minus = smoothed_minus - (smoothed_minus / periods) + minus_dm;
+            }
+            
+            double plus_di = smoothed_tr > 0 ? 100.0 * smoothed_plus / smoothed_tr : 0.0;
+            double minus_di = smoothed_tr > 0 ? 100.0 * smoothed_minus / smoothed_tr : 0.0;
+            
+            double dx = TechnicalIndicators::directionalIndex(plus_di, minus_di);
+            if (dx_count < periods) {
+                adx += dx;
+                if (++dx_count == periods) adx /= periods;
+            } else {
+                adx = ((adx * (periods - 1)) + dx) / periods;
+            }
+            return DirectionalMovement(plus_di, minus_di, dx_count >= periods ? adx : 0.0);
+        }
+    };
+}
+
+double TechnicalIndicators::calculateSMA(CandleSpan data, int periods) {
     if (data.size() < static_cast<size_t>(periods)) return 0.0;
     
     double sum = 0.0;
     for (int i = data.size() - periods; i < static_cast<int>(data.size()); ++i) {
-        sum += data[i].close;
+        sum += data[i].close.toDouble();
     }
     return sum / periods;
 }
 
-double TechnicalIndicators::calculateEMA(const std::vector<OHLCV>& data, int periods) {
+double TechnicalIndicators::calculateEMA(CandleSpan data, int periods) {
     if (data.size() < static_cast<size_t>(periods)) return 0.0;
     
     double multiplier = 2.0 / (periods + 1);
-    double ema = calculateSMA(data, periods); // Start with SMA
+    double ema = calculateSMA(data.first(periods), periods); // Seed with SMA of the first window
     
     for (size_t i = periods; i < data.size(); ++i) {
-        ema = (data[i].close * multiplier) + (ema * (1 - multiplier));
+        ema = (data[i].close.toDouble() * multiplier) + (ema * (1 - multiplier));
     }
     
     return ema;
 }
 
-double TechnicalIndicators::calculateWMA(const std::vector<OHLCV>& data, int periods) {
+double TechnicalIndicators::calculateWMA(CandleSpan data, int periods) {
     if (data.size() < static_cast<size_t>(periods)) return 0.0;
     
     double weighted_sum = 0.0;
@@ -35,20 +153,20 @@ double TechnicalIndicators::calculateWMA(const std::vector<OHLCV>& data, int per
     
     for (int i = 0; i < periods; ++i) {
         int weight = periods - i;
-        weighted_sum += data[data.size() - 1 - i].close * weight;
+        weighted_sum += data[data.size() - 1 - i].close.toDouble() * weight;
         weight_sum += weight;
     }
     
     return weighted_sum / weight_sum;
 }
 
-double TechnicalIndicators::calculateRSI(const std::vector<OHLCV>& data, int periods) {
+double TechnicalIndicators::calculateRSI(CandleSpan data, int periods) {
     if (data.size() < static_cast<size_t>(periods + 1)) return 50.0;
     
     std::vector<double> gains, losses;
     
     for (size_t i = 1; i < data.size(); ++i) {
-        double change = data[i].close - data[i-1].close;
+        double change = (data[i].close - data[i-1].close).toDouble();
         gains.push_back(change > 0 ? change : 0);
         losses.push_back(change < 0 ? -change : 0);
     }
@@ -76,7 +194,7 @@ double TechnicalIndicators::calculateRSI(const std::vector<OHLCV>& data, int per
     return 100.0 - (100.0 / (1.0 + rs));
 }
 
-double TechnicalIndicators::calculateATR(const std::vector<OHLCV>& data, int periods) {
+double TechnicalIndicators::calculateATR(CandleSpan data, int periods) {
     if (data.size() < static_cast<size_t>(periods + 1)) return 0.0;
     
     std::vector<double> true_ranges;
@@ -101,7 +219,7 @@ double TechnicalIndicators::calculateATR(const std::vector<OHLCV>& data, int per
     return atr;
 }
 
-BollingerBands TechnicalIndicators::calculateBollingerBands(const std::vector<OHLCV>& data, 
+BollingerBands TechnicalIndicators::calculateBollingerBands(CandleSpan data, 
                                                            int periods, double multiplier) {
     if (data.size() < static_cast<size_t>(periods)) return BollingerBands();
     
@@ -110,7 +228,7 @@ BollingerBands TechnicalIndicators::calculateBollingerBands(const std::vector<OH
     // Calculate standard deviation
     double sum_sq_diff = 0.0;
     for (int i = data.size() - periods; i < static_cast<int>(data.size()); ++i) {
-        double diff = data[i].close - sma;
+        double diff = data[i].close.toDouble() - sma;
         sum_sq_diff += diff * diff;
     }
     double std_dev = std::sqrt(sum_sq_diff / periods);
@@ -122,7 +240,7 @@ BollingerBands TechnicalIndicators::calculateBollingerBands(const std::vector<OH
     );
 }
 
-double TechnicalIndicators::calculateVWAP(const std::vector<OHLCV>& data) {
+double TechnicalIndicators::calculateVWAP(CandleSpan data) {
     if (data.empty()) return 0.0;
     
     double cumulative_pv = 0.0;
@@ -137,26 +255,104 @@ double TechnicalIndicators::calculateVWAP(const std::vector<OHLCV>& data) {
     return cumulative_volume > 0 ? cumulative_pv / cumulative_volume : 0.0;
 }
 
-MACD TechnicalIndicators::calculateMACD(const std::vector<OHLCV>& data, 
+VWAPBands TechnicalIndicators::calculateVWAPBands(CandleSpan data) {
+    double cumulative_pv = 0.0;
+    double cumulative_p2v = 0.0;
+    long long cumulative_volume = 0;
+    
+    for (const auto& candle : data) {
+        double typical_price = calculateTypicalPrice(candle);
+        cumulative_pv += typical_price * candle.volume;
+        cumulative_p2v += typical_price * typical_price * candle.volume;
+        cumulative_volume += candle.volume;
+    }
+    if (cumulative_volume <= 0) return VWAPBands();
+    
+    double vwap = cumulative_pv / cumulative_volume;
+    double variance = cumulative_p2v / cumulative_volume - vwap * vwap;
+    return VWAPBands(vwap, std::sqrt(std::max(0.0, variance)));
+}
+
+VolumeProfileLevels TechnicalIndicators::calculateVolumeProfile(CandleSpan data, Price bucket_size, double value_area) {
+    if (data.empty() || !bucket_size.isPositive()) return VolumeProfileLevels();
+    
+    const std::int32_t width = bucket_size.paise;
+    std::int32_t first = data[0].low.paise / width;
+    std::int32_t last = data[0].high.paise / width;
+    for (const auto& candle : data) {
+        first = std::min(first, candle.low.paise / width);
+        last = std::max(last, candle.high.paise / width);
+    }
+    if (last < first) return VolumeProfileLevels();
+    
+    std::vector<Quantity> volumes(static_cast<size_t>(last - first) + 1, 0);
+    Quantity total = 0;
+    for (const auto& candle : data) {
+        std::int32_t low = candle.low.paise / width;
+        std::int32_t high = candle.high.paise / width;
+        if (high < low) continue;
+        
+        Quantity buckets = high - low + 1;
+        for (std::int32_t bucket = low; bucket <= high; ++bucket) {
+            volumes[bucket - first] += candle.volume / buckets;
+        }
+        std::int32_t at_close = std::max(low, std::min(high, candle.close.paise / width));
+        volumes[at_close - first] += candle.volume % buckets;
+        total += candle.volume;
+    }
+    
+    size_t poc = 0;
+    for (size_t i = 1; i < volumes.size(); ++i) {
+        if (volumes[i] > volumes[poc]) poc = i;
+    }
+    return volumeProfileLevels(volumes, first, first + static_cast<std::int32_t>(poc), total,
+                               bucket_size, value_area);
+}
+
+MACD TechnicalIndicators::calculateMACD(CandleSpan data, 
                                        int fast_period, int slow_period, int signal_period) {
     if (data.size() < static_cast<size_t>(slow_period)) return MACD();
     
-    double fast_ema = calculateEMA(data, fast_period);
-    double slow_ema = calculateEMA(data, slow_period);
-    double macd_line = fast_ema - slow_ema;
-    
-    // Calculate signal line (EMA of MACD line)
-    // For simplicity, we'll use the current MACD value as signal
-    // In a full implementation, you'd need to track MACD history
-    double signal_line = macd_line * 0.9; // Simplified
+    // The signal line needs the MACD history, so run the EMA chain over the series
+    MacdSeriesState macd(fast_period, slow_period, signal_period);
+    MACD result;
+    for (const auto& candle : data) {
+        result = macd.next(candle);
+    }
+    return result;
+}
+
+double TechnicalIndicators::calculateOBV(CandleSpan data) {
+    Quantity obv = 0;
+    for (size_t i = 1; i < data.size(); ++i) {
+        if (data[i].close > data[i-1].close) {
+            obv += data[i].volume;
+        } else if (data[i].close < data[i-1].close) {
+            obv -= data[i].volume;
+        }
+    }
+    return static_cast<double>(obv);
+}
+
+double TechnicalIndicators::calculateADX(CandleSpan data, int periods) {
+    return calculateDMI(data, periods).adx;
+}
+
+DirectionalMovement TechnicalIndicators::calculateDMI(CandleSpan data, int periods) {
+    if (data.size() < static_cast<size_t>(periods + 1)) return DirectionalMovement();
     
-    return MACD(macd_line, signal_line, macd_line - signal_line);
+    DmiSeriesState dmi(periods);
+    DirectionalMovement result;
+    for (const auto& candle : data) {
+        result = dmi.next(candle);
+    }
+    return result;
 }
 
-double TechnicalIndicators::findSupport(const std::vector<OHLCV>& data, int lookback) {
-    if (data.size() < static_cast<size_t>(lookback)) return 0.0;
+Price TechnicalIndicators::findSupport(CandleSpan data, int lookback) {
+    if (data.size() < static_cast<size_t>(lookback)) return Price();
     
-    double min_low = std::numeric_limits<double>::max();
+    Price min_low = data[data.size() - lookback].low;
     for (int i = data.size() - lookback; i < static_cast<int>(data.size()); ++i) {
         min_low = std::min(min_low, data[i].low);
     }
@@ -164,10 +360,10 @@ double TechnicalIndicators::findSupport(const std::vector<OHLCV>& data, int look
     return min_low;
 }
 
-double TechnicalIndicators::findResistance(const std::vector<OHLCV>& data, int lookback) {
-    if (data.size() < static_cast<size_t>(lookback)) return 0.0;
+Price TechnicalIndicators::findResistance(CandleSpan data, int lookback) {
+    if (data.size() < static_cast<size_t>(lookback)) return Price();
     
-    double max_high = 0.0;
+    Price max_high;
     for (int i = data.size() - lookback; i < static_cast<int>(data.size()); ++i) {
         max_high = std::max(max_high, data[i].high);
     }
@@ -175,29 +371,91 @@ double TechnicalIndicators::findResistance(const std::vector<OHLCV>& data, int l
     return max_high;
 }
 
+DonchianChannel TechnicalIndicators::calculateDonchianChannel(CandleSpan data, int periods) {
+    if (data.size() < static_cast<size_t>(periods)) return DonchianChannel();
+    
+    return DonchianChannel(findResistance(data, periods), findSupport(data, periods));
+}
+
+StochasticOscillator TechnicalIndicators::calculateStochastic(CandleSpan data, int k_periods, int d_periods) {
+    if (data.size() < static_cast<size_t>(k_periods)) return StochasticOscillator();
+    
+    // %K of the window ending just before data[end]
+    auto percentK = [&](size_t end) {
+        auto window = data.first(end).last(k_periods);
+        Price lowest = window[0].low;
+        Price highest = window[0].high;
+        for (const auto& candle : window) {
+            lowest = std::min(lowest, candle.low);
+            highest = std::max(highest, candle.high);
+        }
+        return stochasticK(window.back().close, lowest, highest);
+    };
+    
+    double k = percentK(data.size());
+    size_t k_values = data.size() - k_periods + 1;
+    if (k_values < static_cast<size_t>(d_periods)) return StochasticOscillator(k, 50.0);
+    
+    // %D: average of the last d_periods %K values, oldest first
+    double sum = 0.0;
+    for (int j = d_periods - 1; j >= 0; --j) {
+        sum += percentK(data.size() - j);
+    }
+    return StochasticOscillator(k, sum / d_periods);
+}
+
+double TechnicalIndicators::calculateWilliamsR(CandleSpan data, int periods) {
+    if (data.size() < static_cast<size_t>(periods)) return -50.0;
+    
+    return williamsR(data.back().close, findSupport(data, periods), findResistance(data, periods));
+}
+
+std::vector<double> TechnicalIndicators::findPivotPoints(CandleSpan data) {
+    if (data.empty()) return {};
+    
+    auto levels = calculatePivotLevels(data.back());
+    return {levels.s3, levels.s2, levels.s1, levels.pivot, levels.r1, levels.r2, levels.r3};
+}
+
+PivotLevels TechnicalIndicators::calculatePivotLevels(const OHLCV& session) {
+    double high = session.high.toDouble();
+    double low = session.low.toDouble();
+    double close = session.close.toDouble();
+    
+    PivotLevels levels;
+    levels.pivot = (high + low + close) / 3.0;
+    levels.r1 = 2.0 * levels.pivot - low;
+    levels.s1 = 2.0 * levels.pivot - high;
+    levels.r2 = levels.pivot + (high - low);
+    levels.s2 = levels.pivot - (high - low);
+    levels.r3 = high + 2.0 * (levels.pivot - low);
+    levels.s3 = low - 2.0 * (high - levels.pivot);
+    return levels;
+}
+
 bool TechnicalIndicators::isDoji(const OHLCV& candle, double threshold) {
     if (candle.high == candle.low) return false;
     
-    double body_size = std::abs(candle.close - candle.open);
-    double full_range = candle.high - candle.low;
+    double body_size = std::abs((candle.close - candle.open).toDouble());
+    double full_range = (candle.high - candle.low).toDouble();
     
     return (body_size / full_range) < threshold;
 }
 
 bool TechnicalIndicators::isHammer(const OHLCV& candle) {
-    double body = std::abs(candle.close - candle.open);
-    double lower_shadow = std::min(candle.open, candle.close) - candle.low;
-    double upper_shadow = candle.high - std::max(candle.open, candle.close);
+    Price body = candle.close > candle.open ? candle.close - candle.open : candle.open - candle.close;
+    Price lower_shadow = std::min(candle.open, candle.close) - candle.low;
+    Price upper_shadow = candle.high - std::max(candle.open, candle.close);
     
-    return lower_shadow > 2 * body && upper_shadow < body * 0.5;
+    return lower_shadow > body * 2 && upper_shadow * 2 < body;
 }
 
 bool TechnicalIndicators::isShootingStar(const OHLCV& candle) {
-    double body = std::abs(candle.close - candle.open);
-    double lower_shadow = std::min(candle.open, candle.close) - candle.low;
-    double upper_shadow = candle.high - std::max(candle.open, candle.close);
+    Price body = candle.close > candle.open ? candle.close - candle.open : candle.open - candle.close;
+    Price lower_shadow = std::min(candle.open, candle.close) - candle.low;
+    Price upper_shadow = candle.high - std::max(candle.open, candle.close);
     
-    return upper_shadow > 2 * body && lower_shadow < body * 0.5;
+    return upper_shadow > body * 2 && lower_shadow * 2 < body;
 }
 
 bool TechnicalIndicators::isEngulfing(const OHLCV& prev, const OHLCV& current) {
@@ -219,38 +477,471 @@ bool TechnicalIndicators::isEngulfing(const OHLCV& prev, const OHLCV& current) {
 }
 
 double TechnicalIndicators::calculateTrueRange(const OHLCV& current, const OHLCV& previous) {
-    double hl = current.high - current.low;
-    double hc = std::abs(current.high - previous.close);
-    double lc = std::abs(current.low - previous.close);
+    double hl = (current.high - current.low).toDouble();
+    double hc = std::abs((current.high - previous.close).toDouble());
+    double lc = std::abs((current.low - previous.close).toDouble());
     
     return std::max({hl, hc, lc});
 }
 
 double TechnicalIndicators::calculateTypicalPrice(const OHLCV& candle) {
-    return (candle.high + candle.low + candle.close) / 3.0;
+    return (candle.high.toDouble() + candle.low.toDouble() + candle.close.toDouble()) / 3.0;
+}
+
+double TechnicalIndicators::stochasticK(Price close, Price lowest, Price highest) {
+    if (highest == lowest) return 50.0;
+    return 100.0 * (close - lowest).toDouble() / (highest - lowest).toDouble();
+}
+
+double TechnicalIndicators::williamsR(Price close, Price lowest, Price highest) {
+    if (highest == lowest) return -50.0;
+    return -100.0 * (highest - close).toDouble() / (highest - lowest).toDouble();
+}
+
+double TechnicalIndicators::plusDirectionalMove(const OHLCV& current, const OHLCV& previous) {
+    double up = (current.high - previous.high).toDouble();
+    double down = (previous.low - current.low).toDouble();
+    return (up > down && up > 0) ? up : 0.0;
+}
+
+double TechnicalIndicators::minusDirectionalMove(const OHLCV& current, const OHLCV& previous) {
+    double up = (current.high - previous.high).toDouble();
+    double down = (previous.low - current.low).toDouble();
+    return (down > up && down > 0) ? down : 0.0;
+}
+
+double TechnicalIndicators::directionalIndex(double plus_di, double minus_di) {
+    double sum = plus_di + minus_di;
+    return sum > 0 ? 100.0 * std::abs(plus_di - minus_di) / sum : 0.0;
+}
+
+VolumeProfileLevels TechnicalIndicators::volumeProfileLevels(Span<const Quantity> volumes, std::int32_t first_bucket,
+                                                             std::int32_t poc_bucket, Quantity total,
+                                                             Price bucket_size, double value_area) {
+    VolumeProfileLevels levels;
+    if (total <= 0 || poc_bucket < first_bucket ||
+        static_cast<size_t>(poc_bucket - first_bucket) >= volumes.size()) {
+        return levels;
+    }
+    
+    // Untraded buckets at either end are outside the range
+    size_t begin = 0;
+    size_t end = volumes.size();
+    while (begin < end && volumes[begin] == 0) ++begin;
+    while (end > begin && volumes[end - 1] == 0) --end;
+    
+    size_t low = static_cast<size_t>(poc_bucket - first_bucket);
+    size_t high = low;
+    Quantity inside = volumes[low];
+    while (inside < value_area * total) {
+        bool can_go_down = low > begin;
+        bool can_go_up = high + 1 < end;
+        if (!can_go_down && !can_go_up) break;
+        
+        if (can_go_up && (!can_go_down || volumes[high + 1] >= volumes[low - 1])) {
+            inside += volumes[++high];
+        } else {
+            inside += volumes[--low];
+        }
+    }
+    
+    const std::int32_t width = bucket_size.paise;
+    levels.point_of_control = Price::fromPaise(poc_bucket * width);
+    levels.value_area_low = Price::fromPaise((first_bucket + static_cast<std::int32_t>(low)) * width);
+    levels.value_area_high = Price::fromPaise((first_bucket + static_cast<std::int32_t>(high)) * width);
+    levels.volume = total;
+    return levels;
+}
+
+// Full-series variants
+void TechnicalIndicators::calculateSMASeries(CandleSpan data, int periods, Span<double> out) {
+    size_t n = std::min(data.size(), out.size());
+    size_t window = static_cast<size_t>(periods);
+    std::int64_t sum = 0;   // paise, so the running sum never drifts
+    
+    for (size_t i = 0; i < n; ++i) {
+        sum += data[i].close.paise;
+        if (i >= window) sum -= data[i - window].close.paise;
+        out[i] = (i + 1 >= window) ? static_cast<double>(sum) / periods / 100.0 : 0.0;
+    }
+}
+
+void TechnicalIndicators::calculateEMASeries(CandleSpan data, int periods, Span<double> out) {
+    size_t n = std::min(data.size(), out.size());
+    EmaSeriesState ema(periods);
+    
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = ema.next(data[i]);
+    }
+}
+
+void TechnicalIndicators::calculateWMASeries(CandleSpan data, int periods, Span<double> out) {
+    size_t n = std::min(data.size(), out.size());
+    size_t window = static_cast<size_t>(periods);
+    double weight_sum = periods * (periods + 1) / 2.0;
+    
+    // Weighted and plain window sums in paise. Sliding the window lowers every
+    // weight by one (subtract the plain sum) and adds the new close at full weight.
+    std::int64_t weighted = 0;
+    std::int64_t plain = 0;
+    
+    for (size_t i = 0; i < n; ++i) {
+        std::int64_t close = data[i].close.paise;
+        if (i < window) {
+            weighted += close * static_cast<std::int64_t>(i + 1);
+            plain += close;
+        } else {
+            weighted += close * periods - plain;
+            plain += close - data[i - window].close.paise;
+        }
+        out[i] = (i + 1 >= window) ? weighted / weight_sum / 100.0 : 0.0;
+    }
+}
+
+void TechnicalIndicators::calculateRSISeries(CandleSpan data, int periods, Span<double> out) {
+    size_t n = std::min(data.size(), out.size());
+    size_t warmup = static_cast<size_t>(periods);
+    double avg_gain = 0.0, avg_loss = 0.0;
+    
+    for (size_t i = 0; i < n; ++i) {
+        if (i == 0) {
+            out[i] = 50.0;
+            continue;
+        }
+        
+        double change = (data[i].close - data[i-1].close).toDouble();
+        double gain = change > 0 ? change : 0;
+        double loss = change < 0 ? -change : 0;
+        
+        // i changes seen so far
+        if (i < warmup) {
+            avg_gain += gain;
+            avg_loss += loss;
+            out[i] = 50.0;
+            continue;
+        }
+        if (i == warmup) {
+            avg_gain = (avg_gain + gain) / periods;
+            avg_loss = (avg_loss + loss) / periods;
+        } else {
+            avg_gain = ((avg_gain * (periods - 1)) + gain) / periods;
+            avg_loss = ((avg_loss * (periods - 1)) + loss) / periods;
+        }
+        
+        if (avg_loss == 0) {
+            out[i] = 100.0;
+        } else {
+            double rs = avg_gain / avg_loss;
+            out[i] = 100.0 - (100.0 / (1.0 + rs));
+        }
+    }
+}
+
+void TechnicalIndicators::calculateATRSeries(CandleSpan data, int periods, Span<double> out) {
+    size_t n = std::min(data.size(), out.size());
+    size_t warmup = static_cast<size_t>(periods);
+    double atr = 0.0;
+    
+    for (size_t i = 0; i < n; ++i) {
+        if (i == 0) {
+            out[i] = 0.0;
+            continue;
+        }
+        
+        double true_range = calculateTrueRange(data[i], data[i-1]);
+        if (i < warmup) {
+            atr += true_range;
+            out[i] = 0.0;
+            continue;
+        }
+        if (i == warmup) {
+            atr = (atr + true_range) / periods;
+        } else {
+            atr = ((atr * (periods - 1)) + true_range) / periods;
+        }
+        out[i] = atr;
+    }
+}
+
+void TechnicalIndicators::calculateBollingerBandsSeries(CandleSpan data, int periods, double multiplier,
+                                                        Span<BollingerBands> out) {
+    size_t n = std::min(data.size(), out.size());
+    size_t window = static_cast<size_t>(periods);
+    // Exact integer sums (paise), so the one-pass variance doesn't accumulate error
+    std::int64_t sum = 0;
+    std::int64_t sum_sq = 0;
+    
+    for (size_t i = 0; i < n; ++i) {
+        std::int64_t close = data[i].close.paise;
+        sum += close;
+        sum_sq += close * close;
+        if (i >= window) {
+            std::int64_t oldest = data[i - window].close.paise;
+            sum -= oldest;
+            sum_sq -= oldest * oldest;
+        }
+        
+        if (i + 1 < window) {
+            out[i] = BollingerBands();
+            continue;
+        }
+        
+        double mean = static_cast<double>(sum) / periods;
+        double variance = static_cast<double>(sum_sq) / periods - mean * mean;
+        double std_dev = std::sqrt(std::max(0.0, variance)) / 100.0;
+        double middle = mean / 100.0;
+        out[i] = BollingerBands(middle + (multiplier * std_dev), middle, middle - (multiplier * std_dev));
+    }
+}
+
+void TechnicalIndicators::calculateVWAPSeries(CandleSpan data, Span<double> out) {
+    size_t n = std::min(data.size(), out.size());
+    double cumulative_pv = 0.0;
+    long long cumulative_volume = 0;
+    
+    for (size_t i = 0; i < n; ++i) {
+        cumulative_pv += calculateTypicalPrice(data[i]) * data[i].volume;
+        cumulative_volume += data[i].volume;
+        out[i] = cumulative_volume > 0 ? cumulative_pv / cumulative_volume : 0.0;
+    }
+}
+
+void TechnicalIndicators::calculateMACDSeries(CandleSpan data, int fast_period, int slow_period,
+                                              int signal_period, Span<MACD> out) {
+    size_t n = std::min(data.size(), out.size());
+    MacdSeriesState macd(fast_period, slow_period, signal_period);
+    
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = macd.next(data[i]);
+    }
+}
+
+IndicatorSet TechnicalIndicators::calculateIndicatorSet(CandleSpan data) {
+    constexpr int RSI_PERIODS = 14;
+    constexpr int ATR_PERIODS = 14;
+    constexpr int BOLLINGER_PERIODS = 20;
+    constexpr double BOLLINGER_MULTIPLIER = 2.0;
+    constexpr size_t SR_LOOKBACK = 20;
+    
+    IndicatorSet result;
+    const size_t n = data.size();
+    
+    EmaSeriesState ema_9(9);
+    EmaSeriesState ema_21(21);
+    MacdSeriesState macd(12, 26, 9);
+    double sma_20_sum = 0.0, sma_50_sum = 0.0;
+    std::int64_t bb_sum = 0, bb_sum_sq = 0;   // paise, last BOLLINGER_PERIODS closes
+    double avg_gain = 0.0, avg_loss = 0.0;
+    double atr = 0.0;
+    double cumulative_pv = 0.0;
+    long long cumulative_volume = 0;
+    Price min_low, max_high;
+    
+    for (size_t i = 0; i < n; ++i) {
+        const OHLCV& candle = data[i];
+        double close = candle.close.toDouble();
+        
+        result.ema_9 = ema_9.next(candle);
+        result.ema_21 = ema_21.next(candle);
+        result.macd = macd.next(candle);
+        
+        // Window sums, accumulated oldest-first like calculateSMA
+        if (i + 20 >= n) sma_20_sum += close;
+        if (i + 50 >= n) sma_50_sum += close;
+        if (i + BOLLINGER_PERIODS >= n) {
+            std::int64_t paise = candle.close.paise;
+            bb_sum += paise;
+            bb_sum_sq += paise * paise;
+        }
+        
+        cumulative_pv += calculateTypicalPrice(candle) * candle.volume;
+        cumulative_volume += candle.volume;
+        
+        if (i + SR_LOOKBACK >= n) {
+            if (i + SR_LOOKBACK == n || candle.low < min_low) min_low = candle.low;
+            if (i + SR_LOOKBACK == n || candle.high > max_high) max_high = candle.high;
+        }
+        
+        if (i == 0) continue;
+        
+        // RSI: seed with the first RSI_PERIODS changes, then Wilder smoothing
+        double change = (candle.close - data[i-1].close).toDouble();
+        double gain = change > 0 ? change : 0;
+        double loss = change < 0 ? -change : 0;
+        if (i < static_cast<size_t>(RSI_PERIODS)) {
+            avg_gain += gain;
+            avg_loss += loss;
+        } else if (i == static_cast<size_t>(RSI_PERIODS)) {
+            avg_gain = (avg_gain + gain) / RSI_PERIODS;
+            avg_loss = (avg_loss + loss) / RSI_PERIODS;
+        } else {
+            avg_gain = ((avg_gain * (RSI_PERIODS - 1)) + gain) / RSI_PERIODS;
+            avg_loss = ((avg_loss * (RSI_PERIODS - 1)) + loss) / RSI_PERIODS;
+        }
+        
+        double true_range = calculateTrueRange(candle, data[i-1]);
+        if (i < static_cast<size_t>(ATR_PERIODS)) {
+            atr += true_range;
+        } else if (i == static_cast<size_t>(ATR_PERIODS)) {
+            atr = (atr + true_range) / ATR_PERIODS;
+        } else {
+            atr = ((atr * (ATR_PERIODS - 1)) + true_range) / ATR_PERIODS;
+        }
+    }
+    
+    // Warm-up values match the individual functions
+    if (n >= 20) result.sma_20 = sma_20_sum / 20;
+    if (n >= 50) result.sma_50 = sma_50_sum / 50;
+    if (n > static_cast<size_t>(RSI_PERIODS)) {
+        if (avg_loss == 0) {
+            result.rsi_14 = 100.0;
+        } else {
+            double rs = avg_gain / avg_loss;
+            result.rsi_14 = 100.0 - (100.0 / (1.0 + rs));
+        }
+    }
+    if (n > static_cast<size_t>(ATR_PERIODS)) result.atr_14 = atr;
+    if (n >= static_cast<size_t>(BOLLINGER_PERIODS)) {
+        double mean = static_cast<double>(bb_sum) / BOLLINGER_PERIODS;
+        double variance = static_cast<double>(bb_sum_sq) / BOLLINGER_PERIODS - mean * mean;
+        double std_dev = std::sqrt(std::max(0.0, variance)) / 100.0;
+        double middle = mean / 100.0;
+        result.bollinger = BollingerBands(middle + (BOLLINGER_MULTIPLIER * std_dev), middle,
+                                          middle - (BOLLINGER_MULTIPLIER * std_dev));
+    }
+    if (cumulative_volume > 0) result.vwap = cumulative_pv / cumulative_volume;
+    if (n >= SR_LOOKBACK) {
+        result.support = min_low;
+        result.resistance = max_high;
+    }
+    
+    return result;
+}
+
+void TechnicalIndicators::findSupportSeries(CandleSpan data, int lookback, Span<Price> out) {
+    size_t n = std::min(data.size(), out.size());
+    RollingMin<Price> lows(lookback);
+    
+    for (size_t i = 0; i < n; ++i) {
+        lows.push(data[i].low);
+        out[i] = lows.full() ? lows.value() : Price();
+    }
+}
+
+void TechnicalIndicators::findResistanceSeries(CandleSpan data, int lookback, Span<Price> out) {
+    size_t n = std::min(data.size(), out.size());
+    RollingMax<Price> highs(lookback);
+    
+    for (size_t i = 0; i < n; ++i) {
+        highs.push(data[i].high);
+        out[i] = highs.full() ? highs.value() : Price();
+    }
+}
+
+void TechnicalIndicators::calculateDonchianSeries(CandleSpan data, int periods, Span<DonchianChannel> out) {
+    size_t n = std::min(data.size(), out.size());
+    RollingMin<Price> lows(periods);
+    RollingMax<Price> highs(periods);
+    
+    for (size_t i = 0; i < n; ++i) {
+        lows.push(data[i].low);
+        highs.push(data[i].high);
+        out[i] = lows.full() ? DonchianChannel(highs.value(), lows.value()) : DonchianChannel();
+    }
+}
+
+void TechnicalIndicators::calculateStochasticSeries(CandleSpan data, int k_periods, int d_periods,
+                                                    Span<StochasticOscillator> out) {
+    size_t n = std::min(data.size(), out.size());
+    RollingMin<Price> lows(k_periods);
+    RollingMax<Price> highs(k_periods);
+    
+    for (size_t i = 0; i < n; ++i) {
+        lows.push(data[i].low);
+        highs.push(data[i].high);
+        if (!lows.full()) {
+            out[i] = StochasticOscillator();
+            continue;
+        }
+        
+        double k = stochasticK(data[i].close, lows.value(), highs.value());
+        double d = 50.0;
+        size_t k_values = i + 2 - k_periods;
+        if (k_values >= static_cast<size_t>(d_periods)) {
+            double sum = 0.0;
+            for (int j = d_periods - 1; j > 0; --j) {
+                sum += out[i - j].k;
+            }
+            d = (sum + k) / d_periods;
+        }
+        out[i] = StochasticOscillator(k, d);
+    }
+}
+
+void TechnicalIndicators::calculateWilliamsRSeries(CandleSpan data, int periods, Span<double> out) {
+    size_t n = std::min(data.size(), out.size());
+    RollingMin<Price> lows(periods);
+    RollingMax<Price> highs(periods);
+    
+    for (size_t i = 0; i < n; ++i) {
+        lows.push(data[i].low);
+        highs.push(data[i].high);
+        out[i] = lows.full() ? williamsR(data[i].close, lows.value(), highs.value()) : -50.0;
+    }
+}
+
+void TechnicalIndicators::calculateOBVSeries(CandleSpan data, Span<double> out) {
+    size_t n = std::min(data.size(), out.size());
+    Quantity obv = 0;
+    
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0 && data[i].close > data[i-1].close) {
+            obv += data[i].volume;
+        } else if (i > 0 && data[i].close < data[i-1].close) {
+            obv -= data[i].volume;
+        }
+        out[i] = static_cast<double>(obv);
+    }
+}
+
+void TechnicalIndicators::calculateDMISeries(CandleSpan data, int periods, Span<DirectionalMovement> out) {
+    size_t n = std::min(data.size(), out.size());
+    DmiSeriesState dmi(periods);
+    
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = dmi.next(data[i]);
+    }
+}
+
+void TechnicalIndicators::calculatePivotSeries(CandleSpan data, Span<PivotLevels> out) {
+    size_t n = std::min(data.size(), out.size());
+    
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = calculatePivotLevels(data[i]);
+    }
 }
 
 // Helper functions
-std::vector<double> TechnicalIndicators::extractClosePrices(const std::vector<OHLCV>& data) {
+std::vector<double> TechnicalIndicators::extractClosePrices(CandleSpan data) {
     std::vector<double> prices;
     for (const auto& candle : data) {
-        prices.push_back(candle.close);
+        prices.push_back(candle.close.toDouble());
     }
     return prices;
 }
 
-std::vector<double> TechnicalIndicators::extractHighPrices(const std::vector<OHLCV>& data) {
+std::vector<double> TechnicalIndicators::extractHighPrices(CandleSpan data) {
     std::vector<double> prices;
     for (const auto& candle : data) {
-        prices.push_back(candle.high);
+        prices.push_back(candle.high.toDouble());
     }
     return prices;
 }
 
-std::vector<double> TechnicalIndicators::extractLowPrices(const std::vector<OHLCV>& data) {
+std::vector<double> TechnicalIndicators::extractLowPrices(CandleSpan data) {
     std::vector<double> prices;
     for (const auto& candle : data) {
-        prices.push_back(candle.low);
+        prices.push_back(candle.low.toDouble());
     }
     return prices;
 }
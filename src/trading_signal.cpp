@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cmath>
 #include <sstream>
+#include <cstdio>
 
 // SignalPortfolio methods
 void SignalPortfolio::addSignal(const TradingSignal& signal) {
@@ -92,10 +93,72 @@ namespace SignalUtils {
             case StrategyType::MOMENTUM: return "Momentum";
             case StrategyType::VOLUME_SPIKE: return "Volume Spike";
             case StrategyType::REVERSAL: return "Reversal";
+            case StrategyType::PAIRS: return "Pairs";
             default: return "UNKNOWN";
         }
     }
     
+    const char* signalReasonToString(SignalReason reason) {
+        switch (reason) {
+            case SignalReason::ORB_BREAKOUT: return "ORB Breakout - Price above opening range high";
+            case SignalReason::ORB_BREAKDOWN: return "ORB Breakdown - Price below opening range low";
+            case SignalReason::VWAP_BREAKOUT: return "VWAP Breakout - Price above VWAP with volume";
+            case SignalReason::VWAP_BREAKDOWN: return "VWAP Breakdown - Price below VWAP with volume";
+            case SignalReason::RSI_OVERSOLD: return "RSI Oversold";
+            case SignalReason::RSI_OVERBOUGHT: return "RSI Overbought";
+            case SignalReason::PRICE_BREAKOUT: return "Price Breakout";
+            case SignalReason::VOLUME_SPIKE: return "Volume Spike with Price Alignment";
+            case SignalReason::PAIR_SPREAD_LOW: return "Pair Spread Low - long leg cheap against hedge";
+            case SignalReason::PAIR_SPREAD_HIGH: return "Pair Spread High - long leg rich against hedge";
+            case SignalReason::NONE: return "";
+            default: return "UNKNOWN";
+        }
+    }
+    
+    std::string describeSignal(const TradingSignal& signal) {
+        const char* text = signalReasonToString(signal.reason);
+        double p1 = signal.reason_params[0];
+        double p2 = signal.reason_params[1];
+        
+        char buffer[160];
+        switch (signal.reason) {
+            case SignalReason::ORB_BREAKOUT:
+            case SignalReason::ORB_BREAKDOWN:
+                std::snprintf(buffer, sizeof(buffer), "%s (range %.2f%%)", text, p1);
+                break;
+            case SignalReason::VWAP_BREAKOUT:
+            case SignalReason::VWAP_BREAKDOWN:
+                std::snprintf(buffer, sizeof(buffer), "%s (%+.2f%% from VWAP, %.1fx volume)", text, p1, p2);
+                break;
+            case SignalReason::RSI_OVERSOLD:
+            case SignalReason::RSI_OVERBOUGHT:
+                std::snprintf(buffer, sizeof(buffer), "%s (RSI %.1f)", text, p1);
+                break;
+            case SignalReason::PRICE_BREAKOUT:
+                std::snprintf(buffer, sizeof(buffer), "%s (%.1fx volume)", text, p1);
+                break;
+            case SignalReason::VOLUME_SPIKE:
+                std::snprintf(buffer, sizeof(buffer), "%s (%.1fx volume, %+.2f%%)", text, p1, p2);
+                break;
+            case SignalReason::PAIR_SPREAD_LOW:
+            case SignalReason::PAIR_SPREAD_HIGH:
+                std::snprintf(buffer, sizeof(buffer), "%s (z %+.2f, hedge %.2f)", text, p1, p2);
+                break;
+            default:
+                return text;
+        }
+        return buffer;
+    }
+    
+    std::string formatRiskReward(const TradingSignal& signal) {
+        double ratio = calculateRiskRewardRatio(signal.entry_price, signal.stop_loss, signal.target_1);
+        if (ratio <= 0) return "N/A";
+        
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "1:%.2f", ratio);
+        return buffer;
+    }
+    
     SignalType stringToSignalType(const std::string& str) {
         if (str == "BUY") return SignalType::BUY;
         if (str == "SELL") return SignalType::SELL;
@@ -124,37 +187,38 @@ namespace SignalUtils {
         if (str == "Momentum") return StrategyType::MOMENTUM;
         if (str == "Volume Spike") return StrategyType::VOLUME_SPIKE;
         if (str == "Reversal") return StrategyType::REVERSAL;
+        if (str == "Pairs") return StrategyType::PAIRS;
         return StrategyType::ORB;
     }
     
-    double calculatePositionSize(double account_size, double risk_percentage, 
-                               double entry_price, double stop_loss) {
-        if (entry_price <= 0 || stop_loss <= 0 || entry_price == stop_loss) {
-            return 0.0;
+    Quantity calculatePositionSize(double account_size, double risk_percentage, 
+                                   Price entry_price, Price stop_loss) {
+        if (!entry_price.isPositive() || !stop_loss.isPositive() || entry_price == stop_loss) {
+            return 0;
         }
         
         double risk_amount = account_size * (risk_percentage / 100.0);
-        double risk_per_share = std::abs(entry_price - stop_loss);
+        double risk_per_share = std::abs((entry_price - stop_loss).toDouble());
         
-        return std::floor(risk_amount / risk_per_share);
+        return static_cast<Quantity>(std::floor(risk_amount / risk_per_share));
     }
     
-    double calculateRiskRewardRatio(double entry, double stop_loss, double target) {
-        if (entry <= 0 || stop_loss <= 0 || target <= 0 || entry == stop_loss) {
+    double calculateRiskRewardRatio(Price entry, Price stop_loss, Price target) {
+        if (!entry.isPositive() || !stop_loss.isPositive() || !target.isPositive() || entry == stop_loss) {
             return 0.0;
         }
         
-        double risk = std::abs(entry - stop_loss);
-        double reward = std::abs(target - entry);
+        double risk = std::abs((entry - stop_loss).toDouble());
+        double reward = std::abs((target - entry).toDouble());
         
         return reward / risk;
     }
     
     bool isValidSignal(const TradingSignal& signal) {
         // Basic validation checks
-        if (signal.symbol.empty()) return false;
-        if (signal.entry_price <= 0) return false;
-        if (signal.stop_loss <= 0) return false;
+        if (signal.symbol == INVALID_SYMBOL_ID) return false;
+        if (!signal.entry_price.isPositive()) return false;
+        if (!signal.stop_loss.isPositive()) return false;
         if (signal.confidence < 0 || signal.confidence > 1) return false;
         
         // Check if stop loss makes sense relative to entry
@@ -165,7 +229,7 @@ namespace SignalUtils {
         }
         
         // Check if targets make sense
-        if (signal.target_1 > 0) {
+        if (signal.target_1.isPositive()) {
             if (signal.type == SignalType::BUY || signal.type == SignalType::STRONG_BUY) {
                 if (signal.target_1 <= signal.entry_price) return false;
             } else if (signal.type == SignalType::SELL || signal.type == SignalType::STRONG_SELL) {
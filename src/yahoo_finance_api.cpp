@@ -14,6 +14,8 @@ using json = nlohmann::json;
 const std::string YahooFinanceAPI::QUOTE_BASE_URL = "https://query1.finance.yahoo.com/v8/finance/chart";
 const std::string YahooFinanceAPI::HISTORICAL_BASE_URL = "https://query1.finance.yahoo.com/v8/finance/chart";
 const std::string YahooFinanceAPI::CHART_BASE_URL = "https://query1.finance.yahoo.com/v8/finance/chart";
+const std::string YahooFinanceAPI::PRIMARY_INDEX = "^NSEI";
+const std::string YahooFinanceAPI::DAILY_HISTORY_RANGE = "6mo";
 
 // Callback for curl to write data
 static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* response) {
@@ -22,9 +24,49 @@ static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::stri
     return totalSize;
 }
 
+// Walk the valid candles of a chart "result" object in timestamp order
+template <typename Callback>
+static void forEachChartCandle(const json& result, Callback&& callback) {
+    if (!result.contains("timestamp") || !result.contains("indicators") ||
+        !result["indicators"].contains("quote") ||
+        result["indicators"]["quote"].empty()) {
+        return;
+    }
+    
+    const auto& timestamps = result["timestamp"];
+    const auto& quote = result["indicators"]["quote"][0];
+    
+    auto opens = quote.value("open", json::array());
+    auto highs = quote.value("high", json::array());
+    auto lows = quote.value("low", json::array());
+    auto closes = quote.value("close", json::array());
+    auto volumes = quote.value("volume", json::array());
+    
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        if (i < opens.size() && i < highs.size() && 
+            i < lows.size() && i < closes.size() && i < volumes.size()) {
+            
+            OHLCV candle;
+            candle.open = Price::fromRupees(opens[i].is_null() ? 0.0 : opens[i].get<double>());
+            candle.high = Price::fromRupees(highs[i].is_null() ? 0.0 : highs[i].get<double>());
+            candle.low = Price::fromRupees(lows[i].is_null() ? 0.0 : lows[i].get<double>());
+            candle.close = Price::fromRupees(closes[i].is_null() ? 0.0 : closes[i].get<double>());
+            candle.volume = volumes[i].is_null() ? 0LL : volumes[i].get<long long>();
+            
+            auto timestamp_sec = timestamps[i].get<long long>();
+            candle.timestamp = std::chrono::system_clock::from_time_t(timestamp_sec);
+            
+            if (candle.open.isPositive() && candle.high.isPositive() && 
+                candle.low.isPositive() && candle.close.isPositive()) {
+                callback(candle);
+            }
+        }
+    }
+}
+
 YahooFinanceAPI::YahooFinanceAPI() 
     : timeout_seconds_(30), retry_count_(3), rate_limit_(100),
-      last_request_(std::chrono::steady_clock::now()) {
+      last_request_(std::chrono::steady_clock::now()), correlations_(0, 60), pairs_(0, 120, 15) {
     curl_global_init(CURL_GLOBAL_DEFAULT);
 }
 
@@ -33,29 +75,35 @@ YahooFinanceAPI::~YahooFinanceAPI() {
 }
 
 std::vector<StockData> YahooFinanceAPI::getQuotes(const std::vector<std::string>& symbols) {
-    if (symbols.empty()) return {};
-    
-    std::vector<StockData> result;
+    MarketSnapshot snapshot;
+    fetchQuotes(symbols, snapshot);
+    return snapshot.stocks;
+}
+
+void YahooFinanceAPI::fetchQuotes(const std::vector<std::string>& symbols, MarketSnapshot& out) {
+    if (symbols.empty()) return;
     
     try {
         // Since we can't batch request multiple symbols with the chart endpoint,
         // we need to make individual requests
         for (const auto& symbol : symbols) {
+            if (!DataValidator::isValidSymbol(symbol)) continue;
+            
             enforceRateLimit();
             std::string url = CHART_BASE_URL + "/" + HttpUtils::urlEncode(symbol) + 
                              "?interval=1m&range=1d";
             std::string response = makeHttpRequest(url);
-            auto stock_data = parseChartResponseForQuote(response, symbol);
-            if (!stock_data.symbol.empty()) {
-                result.push_back(stock_data);
+            StockInfo info;
+            auto stock_data = parseChartResponseForQuote(response, symbol, info);
+            if (stock_data.symbol_id != INVALID_SYMBOL_ID) {
+                out.add(stock_data, info);
+                market_breadth_.update(stock_data);
             }
         }
     } catch (const std::exception& e) {
         last_error_ = "Error fetching quotes: " + std::string(e.what());
         std::cout << "❌ API Error: " << last_error_ << std::endl;
     }
-    
-    return result;
 }
 
 StockData YahooFinanceAPI::getQuote(const std::string& symbol) {
@@ -69,9 +117,11 @@ std::future<std::vector<StockData>> YahooFinanceAPI::getQuotesAsync(const std::v
     });
 }
 
-std::map<std::string, StockData> YahooFinanceAPI::getAllNifty50Data() {
-    std::map<std::string, StockData> result;
+std::shared_ptr<const MarketSnapshot> YahooFinanceAPI::getNifty50Snapshot() {
+    auto snapshot = std::make_shared<MarketSnapshot>();
     auto symbols = MarketDataUtils::getNifty50Symbols();
+    snapshot->stocks.reserve(symbols.size());
+    snapshot->info.reserve(symbols.size());
     
     // Split into batches of 10 to avoid URL length limits
     const size_t batch_size = 10;
@@ -79,10 +129,7 @@ std::map<std::string, StockData> YahooFinanceAPI::getAllNifty50Data() {
         size_t end = std::min(i + batch_size, symbols.size());
         std::vector<std::string> batch(symbols.begin() + i, symbols.begin() + end);
         
-        auto batch_data = getQuotes(batch);
-        for (const auto& stock : batch_data) {
-            result[stock.symbol] = stock;
-        }
+        fetchQuotes(batch, *snapshot);
         
         // Small delay between batches
         if (end < symbols.size()) {
@@ -90,63 +137,27 @@ std::map<std::string, StockData> YahooFinanceAPI::getAllNifty50Data() {
         }
     }
     
+    snapshot->update_time = std::chrono::system_clock::now();
+    if (market_breadth_.needsReference()) loadIndexReference();
+    snapshot->breadth = market_breadth_.breadth();
+    updateCorrelations();
+    updatePatterns(*snapshot);
+    snapshot->daily_cache_hit_rate = indicators_.dailyCacheStats().hitRate();
+    snapshot->intraday_cache_hit_rate = indicators_.intradayCacheStats().hitRate();
+    return snapshot;
+}
+
+std::map<std::string, StockData> YahooFinanceAPI::getAllNifty50Data() {
+    std::map<std::string, StockData> result;
+    auto snapshot = getNifty50Snapshot();
+    for (size_t i = 0; i < snapshot->size(); ++i) {
+        result[snapshot->info[i].symbol] = snapshot->stocks[i];
+    }
     return result;
 }
 
 MarketScan YahooFinanceAPI::getMarketScan() {
-    MarketScan scan;
-    auto all_data = getAllNifty50Data();
-    
-    // Convert map to vector for sorting
-    std::vector<StockData> stocks;
-    for (const auto& pair : all_data) {
-        stocks.push_back(pair.second);
-    }
-    
-    // Sort for top gainers
-    auto gainers = stocks;
-    std::sort(gainers.begin(), gainers.end(), 
-              [](const StockData& a, const StockData& b) {
-                  return a.change_percent > b.change_percent;
-              });
-    scan.top_gainers = std::vector<StockData>(gainers.begin(), 
-                                            gainers.begin() + std::min(10ul, gainers.size()));
-    
-    // Sort for top losers
-    auto losers = stocks;
-    std::sort(losers.begin(), losers.end(),
-              [](const StockData& a, const StockData& b) {
-                  return a.change_percent < b.change_percent;
-              });
-    scan.top_losers = std::vector<StockData>(losers.begin(),
-                                           losers.begin() + std::min(10ul, losers.size()));
-    
-    // High volume stocks
-    auto high_vol = stocks;
-    std::sort(high_vol.begin(), high_vol.end(),
-              [](const StockData& a, const StockData& b) {
-                  return a.volume_ratio > b.volume_ratio;
-              });
-    scan.high_volume = std::vector<StockData>(high_vol.begin(),
-                                            high_vol.begin() + std::min(10ul, high_vol.size()));
-    
-    // Breakout candidates
-    for (const auto& stock : stocks) {
-        if (stock.is_breakout) {
-            scan.breakout_candidates.push_back(stock);
-        }
-        if (stock.is_breakdown) {
-            scan.breakdown_candidates.push_back(stock);
-        }
-        if (stock.near_support) {
-            scan.near_support.push_back(stock);
-        }
-        if (stock.near_resistance) {
-            scan.near_resistance.push_back(stock);
-        }
-    }
-    
-    return scan;
+    return MarketDataUtils::buildMarketScan(getNifty50Snapshot());
 }
 
 std::string YahooFinanceAPI::makeHttpRequest(const std::string& url) {
@@ -183,9 +194,7 @@ std::string YahooFinanceAPI::buildQuoteUrl(const std::vector<std::string>& symbo
     return url;
 }
 
-std::vector<StockData> YahooFinanceAPI::parseQuoteResponse(const std::string& json_str) {
-    std::vector<StockData> stocks;
-    
+void YahooFinanceAPI::parseQuoteResponse(const std::string& json_str, MarketSnapshot& out) {
     try {
         auto json_data = json::parse(json_str);
         
@@ -194,19 +203,22 @@ std::vector<StockData> YahooFinanceAPI::parseQuoteResponse(const std::string& js
             
             for (const auto& quote : json_data["quoteResponse"]["result"]) {
                 StockData stock;
+                StockInfo info;
                 
                 // Basic data
-                stock.symbol = quote.value("symbol", "");
-                stock.name = quote.value("shortName", stock.symbol);
-                stock.current_price = quote.value("regularMarketPrice", 0.0);
-                stock.previous_close = quote.value("regularMarketPreviousClose", 0.0);
-                stock.change = quote.value("regularMarketChange", 0.0);
+                info.symbol = quote.value("symbol", "");
+                if (!DataValidator::isValidSymbol(info.symbol)) continue;
+                info.name = quote.value("shortName", info.symbol);
+                info.market_cap = quote.value("marketCap", 0.0);
+                stock.symbol_id = SymbolTable::intern(info.symbol);
+                stock.current_price = Price::fromRupees(quote.value("regularMarketPrice", 0.0));
+                stock.previous_close = Price::fromRupees(quote.value("regularMarketPreviousClose", 0.0));
+                stock.change = Price::fromRupees(quote.value("regularMarketChange", 0.0));
                 stock.change_percent = quote.value("regularMarketChangePercent", 0.0);
                 stock.volume = quote.value("regularMarketVolume", 0LL);
                 stock.avg_volume = quote.value("averageDailyVolume10Day", 0LL);
-                stock.market_cap = quote.value("marketCap", 0.0);
-                stock.day_high = quote.value("regularMarketDayHigh", 0.0);
-                stock.day_low = quote.value("regularMarketDayLow", 0.0);
+                stock.day_high = Price::fromRupees(quote.value("regularMarketDayHigh", 0.0));
+                stock.day_low = Price::fromRupees(quote.value("regularMarketDayLow", 0.0));
                 
                 // Calculate derived metrics
                 if (stock.avg_volume > 0) {
@@ -214,28 +226,27 @@ std::vector<StockData> YahooFinanceAPI::parseQuoteResponse(const std::string& js
                 }
                 
                 stock.volume_spike = stock.volume_ratio > 1.5;
-                stock.last_update = std::chrono::system_clock::now();
+                info.last_update = std::chrono::system_clock::now();
                 
                 // Get historical data for technical indicators
-                auto historical = getHistoricalData(stock.symbol, "1mo", "1d");
+                auto historical = getHistoricalData(info.symbol, DAILY_HISTORY_RANGE, "1d");
                 calculateTechnicalIndicators(stock, historical);
                 identifyPatterns(stock);
                 
                 DataValidator::sanitizeStockData(stock);
-                stocks.push_back(stock);
+                out.add(stock, info);
             }
         }
     } catch (const std::exception& e) {
         last_error_ = "JSON parsing error: " + std::string(e.what());
     }
-    
-    return stocks;
 }
 
 // New function to parse chart endpoint for quote data
-StockData YahooFinanceAPI::parseChartResponseForQuote(const std::string& json_str, const std::string& symbol) {
+StockData YahooFinanceAPI::parseChartResponseForQuote(const std::string& json_str, const std::string& symbol,
+                                                      StockInfo& info) {
     StockData stock;
-    stock.symbol = symbol;
+    info.symbol = symbol;
     
     try {
         auto json_data = json::parse(json_str);
@@ -248,17 +259,19 @@ StockData YahooFinanceAPI::parseChartResponseForQuote(const std::string& json_st
             auto meta = result.value("meta", json::object());
             
             // Extract basic info from meta
-            stock.symbol = meta.value("symbol", symbol);
-            stock.current_price = meta.value("regularMarketPrice", 0.0);
-            stock.previous_close = meta.value("previousClose", 0.0);
-            stock.day_high = meta.value("regularMarketDayHigh", 0.0);
-            stock.day_low = meta.value("regularMarketDayLow", 0.0);
+            info.symbol = meta.value("symbol", symbol);
+            info.name = meta.value("longName", meta.value("shortName", info.symbol));
+            stock.symbol_id = SymbolTable::intern(info.symbol);
+            stock.current_price = Price::fromRupees(meta.value("regularMarketPrice", 0.0));
+            stock.previous_close = Price::fromRupees(meta.value("previousClose", 0.0));
+            stock.day_high = Price::fromRupees(meta.value("regularMarketDayHigh", 0.0));
+            stock.day_low = Price::fromRupees(meta.value("regularMarketDayLow", 0.0));
             stock.volume = meta.value("regularMarketVolume", 0LL);
             
             // Calculate change
-            if (stock.previous_close > 0) {
+            if (stock.previous_close.isPositive()) {
                 stock.change = stock.current_price - stock.previous_close;
-                stock.change_percent = (stock.change / stock.previous_close) * 100.0;
+                stock.change_percent = (stock.change.toDouble() / stock.previous_close.toDouble()) * 100.0;
             }
             
             // Get latest OHLCV data from indicators if available
@@ -274,18 +287,43 @@ StockData YahooFinanceAPI::parseChartResponseForQuote(const std::string& json_st
                 }
             }
             
-            stock.last_update = std::chrono::system_clock::now();
+            // Keep the session's 1m bars in the bounded per-symbol store, rolled
+            // up into 5m/15m/daily, and feed each timeframe's indicators
+            loadVolumeHistory(info.symbol, stock.symbol_id);
+            AnomalyCheck newest;
+            forEachChartCandle(result, [this, &stock, &newest](const OHLCV& candle) {
+                // Bad prints stay out of every series; shocks go through. Only
+                // the newest bar's check is reported, so a later clean bar
+                // lifts an earlier quarantine and old shocks are not re-raised.
+                auto check = anomalies_.check(stock.symbol_id, candle);
+                newest = check;
+                if (check.type == AnomalyType::BAD_PRINT) return;
+                
+                intraday_bars_.ingestBase(stock.symbol_id, candle);
+                indicators_.updateIntraday(stock.symbol_id, candle);
+                relative_volume_.update(stock.symbol_id, candle);
+            });
+            for (BarInterval interval : {BarInterval::ONE_MINUTE, BarInterval::FIVE_MINUTES,
+                                         BarInterval::FIFTEEN_MINUTES}) {
+                indicators_.updateTimeframe(stock.symbol_id, interval, intraday_bars_.bars(stock.symbol_id, interval));
+            }
+            stock.anomaly = newest.type;
+            stock.anomaly_z = newest.type == AnomalyType::VOLUME_SHOCK ? newest.volume_z : newest.return_z;
+            stock.anomaly_new = newest.fresh;
+            
+            info.last_update = std::chrono::system_clock::now();
             
             // Get historical data for technical indicators
-            auto historical = getHistoricalData(stock.symbol, "1mo", "1d");
+            auto historical = getHistoricalData(info.symbol, DAILY_HISTORY_RANGE, "1d");
             calculateTechnicalIndicators(stock, historical);
+            relative_volume_.apply(stock.symbol_id, stock);
             identifyPatterns(stock);
             
             DataValidator::sanitizeStockData(stock);
             
-            std::cout << "✅ Fetched data for " << stock.symbol 
+            std::cout << "✅ Fetched data for " << info.symbol 
                       << " - Price: $" << stock.current_price 
-                      << " (" << (stock.change >= 0 ? "+" : "") << stock.change_percent << "%)" << std::endl;
+                      << " (" << (stock.change >= Price() ? "+" : "") << stock.change_percent << "%)" << std::endl;
         }
     } catch (const std::exception& e) {
         last_error_ = "Chart parsing error for " + symbol + ": " + std::string(e.what());
@@ -316,8 +354,9 @@ HistoricalData YahooFinanceAPI::getHistoricalData(const std::string& symbol,
 std::string YahooFinanceAPI::buildHistoricalUrl(const std::string& symbol,
                                                const std::string& period,
                                                const std::string& interval) {
+    // Ask for the requested range only, not the full listing history
     return CHART_BASE_URL + "/" + HttpUtils::urlEncode(symbol) +
-           "?period1=0&period2=9999999999&interval=" + interval;
+           "?range=" + period + "&interval=" + interval;
 }
 
 HistoricalData YahooFinanceAPI::parseHistoricalResponse(const std::string& json_str) {
@@ -333,39 +372,9 @@ HistoricalData YahooFinanceAPI::parseHistoricalResponse(const std::string& json_
             auto result = json_data["chart"]["result"][0];
             data.symbol = result.value("meta", json::object()).value("symbol", "");
             
-            if (result.contains("timestamp") && result.contains("indicators") &&
-                result["indicators"].contains("quote") &&
-                !result["indicators"]["quote"].empty()) {
-                
-                auto timestamps = result["timestamp"];
-                auto quote = result["indicators"]["quote"][0];
-                
-                auto opens = quote.value("open", json::array());
-                auto highs = quote.value("high", json::array());
-                auto lows = quote.value("low", json::array());
-                auto closes = quote.value("close", json::array());
-                auto volumes = quote.value("volume", json::array());
-                
-                for (size_t i = 0; i < timestamps.size(); ++i) {
-                    if (i < opens.size() && i < highs.size() && 
-                        i < lows.size() && i < closes.size() && i < volumes.size()) {
-                        
-                        OHLCV candle;
-                        candle.open = opens[i].is_null() ? 0.0 : opens[i].get<double>();
-                        candle.high = highs[i].is_null() ? 0.0 : highs[i].get<double>();
-                        candle.low = lows[i].is_null() ? 0.0 : lows[i].get<double>();
-                        candle.close = closes[i].is_null() ? 0.0 : closes[i].get<double>();
-                        candle.volume = volumes[i].is_null() ? 0LL : volumes[i].get<long long>();
-                        
-                        auto timestamp_sec = timestamps[i].get<long long>();
-                        candle.timestamp = std::chrono::system_clock::from_time_t(timestamp_sec);
-                        
-                        if (candle.open > 0 && candle.high > 0 && candle.low > 0 && candle.close > 0) {
-                            data.candles.push_back(candle);
-                        }
-                    }
-                }
-            }
+            forEachChartCandle(result, [&data](const OHLCV& candle) {
+                data.candles.push_back(candle);
+            });
         }
     } catch (const std::exception& e) {
         last_error_ = "Historical data parsing error: " + std::string(e.what());
@@ -375,49 +384,118 @@ HistoricalData YahooFinanceAPI::parseHistoricalResponse(const std::string& json_
 }
 
 void YahooFinanceAPI::calculateTechnicalIndicators(StockData& stock, const HistoricalData& historical) {
-    if (historical.candles.size() < 20) return;
-    
-    TechnicalIndicators calc;
-    
-    // Calculate RSI
-    stock.rsi_14 = calc.calculateRSI(historical.candles, 14);
-    
-    // Calculate moving averages
-    stock.sma_20 = calc.calculateSMA(historical.candles, 20);
-    stock.sma_50 = calc.calculateSMA(historical.candles, 50);
-    stock.ema_9 = calc.calculateEMA(historical.candles, 9);
-    stock.ema_21 = calc.calculateEMA(historical.candles, 21);
-    
-    // Calculate VWAP
-    stock.vwap = calc.calculateVWAP(historical.candles);
-    
-    // Calculate ATR
-    stock.atr_14 = calc.calculateATR(historical.candles, 14);
-    
-    // Calculate Bollinger Bands
-    auto bb = calc.calculateBollingerBands(historical.candles, 20, 2.0);
-    stock.bollinger_upper = bb.upper;
-    stock.bollinger_lower = bb.lower;
-    
-    // Calculate support and resistance
-    stock.support_level = calc.findSupport(historical.candles, 20);
-    stock.resistance_level = calc.findResistance(historical.candles, 20);
+    // One sweep over the bars newer than the last fetch (plus today's
+    // in-progress bar) updates every indicator, support/resistance included;
+    // the session VWAP was already fed from the 1m bars
+    indicators_.updateDaily(stock.symbol_id, historical.candles);
+    indicators_.apply(stock.symbol_id, stock);
 }
 
 void YahooFinanceAPI::identifyPatterns(StockData& stock) {
-    // Breakout detection
-    stock.is_breakout = (stock.current_price > stock.resistance_level * 1.001) && 
+    // Breakout detection (0.1% above resistance)
+    stock.is_breakout = PriceUtils::isAboveByBps(stock.current_price, stock.resistance_level, 10) && 
                         stock.volume_spike;
     
-    // Breakdown detection  
-    stock.is_breakdown = (stock.current_price < stock.support_level * 0.999) && 
+    // Breakdown detection (0.1% below support)
+    stock.is_breakdown = PriceUtils::isBelowByBps(stock.current_price, stock.support_level, 10) && 
                          stock.volume_spike;
     
-    // Near support/resistance
-    stock.near_support = std::abs(stock.current_price - stock.support_level) / 
-                         stock.support_level < 0.02;
-    stock.near_resistance = std::abs(stock.current_price - stock.resistance_level) / 
-                            stock.resistance_level < 0.02;
+    // Near support/resistance (within 2%), or at the edge of the session's
+    // value area (within 0.25%)
+    stock.near_support = PriceUtils::isWithinBps(stock.current_price, stock.support_level, 200) ||
+                         (stock.value_area_low.isPositive() &&
+                          PriceUtils::isWithinBps(stock.current_price, stock.value_area_low, 25));
+    stock.near_resistance = PriceUtils::isWithinBps(stock.current_price, stock.resistance_level, 200) ||
+                            (stock.value_area_high.isPositive() &&
+                             PriceUtils::isWithinBps(stock.current_price, stock.value_area_high, 25));
+}
+
+void YahooFinanceAPI::updateCorrelations() {
+    correlations_.resize(SymbolTable::size());
+    pairs_.resize(SymbolTable::size());
+    pairs_.collectTests();
+    
+    // Each symbol's newest 1m bar is still forming; correlate completed minutes only
+    auto completed = std::chrono::system_clock::time_point::min();
+    for (SymbolId id = 0; id < correlations_.size(); ++id) {
+        auto bars = intraday_bars_.bars(id, BarInterval::ONE_MINUTE);
+        if (bars.size() >= 2) completed = std::max(completed, bars[bars.size() - 2].timestamp);
+    }
+    if (completed <= last_correlated_minute_ || completed == std::chrono::system_clock::time_point::min()) return;
+    
+    // One row per minute since the last update, at most the longer window's
+    // worth; the first call backfills that much from the session in the store
+    const auto one_minute = std::chrono::minutes(1);
+    size_t backfill = std::max(correlations_.window(), pairs_.window());
+    auto earliest = completed - one_minute * static_cast<int>(backfill - 1);
+    auto minute = last_correlated_minute_ == std::chrono::system_clock::time_point()
+                      ? earliest : std::max(last_correlated_minute_ + one_minute, earliest);
+    
+    std::vector<std::int32_t> closes(correlations_.size(), 0);
+    std::vector<size_t> next_bar(correlations_.size(), 0);   // per symbol, first bar after the last minute
+    for (; minute <= completed; minute += one_minute) {
+        // Latest completed close at or before `minute`; skip minutes no symbol traded
+        bool traded = false;
+        for (SymbolId id = 0; id < correlations_.size(); ++id) {
+            auto bars = intraday_bars_.bars(id, BarInterval::ONE_MINUTE);
+            size_t done = bars.size() >= 2 ? bars.size() - 1 : 0;
+            size_t& next = next_bar[id];
+            while (next < done && bars[next].timestamp <= minute) ++next;
+            closes[id] = next > 0 ? bars[next - 1].close.paise : 0;
+            traded = traded || (next > 0 && bars[next - 1].timestamp == minute);
+        }
+        if (traded) {
+            correlations_.update(closes);
+            pairs_.update(closes);
+        }
+    }
+    last_correlated_minute_ = completed;
+}
+
+void YahooFinanceAPI::loadVolumeHistory(const std::string& symbol, SymbolId symbol_id) {
+    if (symbol_id >= volume_history_loaded_.size()) volume_history_loaded_.resize(symbol_id + 1, 0);
+    if (volume_history_loaded_[symbol_id]) return;
+    volume_history_loaded_[symbol_id] = 1;
+    
+    // Once per symbol: the last few sessions' 1m bars build the volume curve;
+    // after that each session is folded in as the next one starts
+    auto history = getHistoricalData(symbol, "5d", "1m");
+    relative_volume_.update(symbol_id, history.candles);
+}
+
+void YahooFinanceAPI::loadIndexReference() {
+    // Once per session; if the index quote is unavailable, retry at most once a minute
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_index_reference_attempt_ < std::chrono::minutes(1)) return;
+    last_index_reference_attempt_ = now;
+    
+    try {
+        enforceRateLimit();
+        std::string url = CHART_BASE_URL + "/" + HttpUtils::urlEncode(PRIMARY_INDEX) + "?interval=1d&range=1d";
+        auto json_data = json::parse(makeHttpRequest(url));
+        if (json_data.contains("chart") && json_data["chart"].contains("result") &&
+            !json_data["chart"]["result"].empty()) {
+            auto meta = json_data["chart"]["result"][0].value("meta", json::object());
+            double previous_close = meta.value("previousClose", meta.value("chartPreviousClose", 0.0));
+            if (previous_close > 0) market_breadth_.setReference(previous_close);
+        }
+    } catch (const std::exception& e) {
+        last_error_ = "Error fetching index reference: " + std::string(e.what());
+    }
+}
+
+void YahooFinanceAPI::updatePatterns(MarketSnapshot& snapshot) {
+    // The newest 1m bar is still forming; scan completed bars only
+    std::vector<CandleSpan> universe(intraday_bars_.symbolCount());
+    for (SymbolId id = 0; id < universe.size(); ++id) {
+        auto bars = intraday_bars_.bars(id, BarInterval::ONE_MINUTE);
+        if (!bars.empty()) universe[id] = bars.first(bars.size() - 1);
+    }
+    patterns_.scan(universe);
+    
+    for (auto& stock : snapshot.stocks) {
+        stock.candle_patterns = patterns_.latest(stock.symbol_id);
+    }
 }
 
 void YahooFinanceAPI::enforceRateLimit() {
@@ -432,6 +510,50 @@ void YahooFinanceAPI::enforceRateLimit() {
     last_request_ = std::chrono::steady_clock::now();
 }
 
+void YahooFinanceAPI::configureBarStore(const BarStoreConfig& config) {
+    intraday_bars_.configure(config);
+}
+
+const IntradayBarStore& YahooFinanceAPI::getIntradayBars() const {
+    return intraday_bars_;
+}
+
+size_t YahooFinanceAPI::trimColdBars(size_t bytes_to_free) {
+    return intraday_bars_.trimColdHistory(bytes_to_free);
+}
+
+size_t YahooFinanceAPI::restoreBarCapacity(size_t bytes_available) {
+    return intraday_bars_.restoreCapacity(bytes_available);
+}
+
+const IndicatorEngine& YahooFinanceAPI::getIndicators() const {
+    return indicators_;
+}
+
+const CorrelationMatrix& YahooFinanceAPI::getCorrelations() const {
+    return correlations_;
+}
+
+const PairsScanner& YahooFinanceAPI::getPairs() const {
+    return pairs_;
+}
+
+const PatternScanner& YahooFinanceAPI::getPatterns() const {
+    return patterns_;
+}
+
+const RelativeVolumeEngine& YahooFinanceAPI::getRelativeVolume() const {
+    return relative_volume_;
+}
+
+const AnomalyMonitor& YahooFinanceAPI::getAnomalies() const {
+    return anomalies_;
+}
+
+const MarketBreadthEngine& YahooFinanceAPI::getMarketBreadth() const {
+    return market_breadth_;
+}
+
 void YahooFinanceAPI::setTimeout(int timeout_seconds) {
     timeout_seconds_ = timeout_seconds;
 }
@@ -483,6 +605,10 @@ namespace DataValidator {
         return price > 0 && price < 1000000 && std::isfinite(price);
     }
     
+    bool isValidPrice(Price price) {
+        return price.isPositive() && price < Price::fromPaise(1000000LL * 100);
+    }
+    
     bool isValidVolume(long long volume) {
         return volume >= 0 && volume < LLONG_MAX;
     }
@@ -492,10 +618,9 @@ namespace DataValidator {
     }
     
     void sanitizeStockData(StockData& data) {
-        if (!isValidPrice(data.current_price)) data.current_price = 0;
-        if (!isValidPrice(data.previous_close)) data.previous_close = 0;
+        if (!isValidPrice(data.current_price)) data.current_price = Price();
+        if (!isValidPrice(data.previous_close)) data.previous_close = Price();
         if (!isValidVolume(data.volume)) data.volume = 0;
-        if (!isValidSymbol(data.symbol)) data.symbol = "UNKNOWN";
         
         // Ensure percentages are reasonable
         if (std::abs(data.change_percent) > 100) data.change_percent = 0;